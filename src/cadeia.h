@@ -0,0 +1,45 @@
+/* *****************************************************************************
+   Copyright (c) 2025 I.F.F. dos Santos <ismaellxd@gmail.com>
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the “Software”), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+***************************************************************************** */
+#ifndef CADEIA_H
+#define CADEIA_H 1
+/* ---
+   Formato binario nativo da descricao da cadeia lida por `classico`.
+   O arquivo comeca com um `cabecalho_cadeia` e segue com as quatro
+   colunas do formato de texto, uma apos a outra: as N massas, as N
+   constantes de acoplamento, os N deslocamentos e os N momentos iniciais,
+   todos como double na ordem de bytes da maquina. Ele eh carregado sem
+   nenhuma conversao e pode ser gerado com `conversor -c`.
+--- */
+#include <stdint.h>
+
+#define CADEIA_MAGICA "PVICADE"
+#define CADEIA_VERSAO UINT32_C(1)
+#define CADEIA_DOUBLE UINT32_C(8)
+
+typedef struct {
+   char magica[8]; /* CADEIA_MAGICA com o '\0' */
+   uint32_t versao;
+   uint32_t tipo; /* tamanho em bytes de cada numero */
+   uint64_t N; /* numero de corpos */
+} cabecalho_cadeia;
+
+#endif /* CADEIA_H */
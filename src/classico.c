@@ -19,11 +19,39 @@
    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
    IN THE SOFTWARE.
 ***************************************************************************** */
+#define _POSIX_C_SOURCE 200809L
+#ifdef CLASSICO_PERFIL
+#define _DEFAULT_SOURCE /* syscall, para o perf_event_open */
+#endif
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <float.h>
 #include <math.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#ifdef CLASSICO_PERFIL
+#include <inttypes.h>
+#endif
+#if defined(CLASSICO_PERFIL) && defined(__linux__)
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#include "rede.h"
+#define PVI_CORPUS real
 #include "pvi.h"
+#include "trajetoria.h"
+#include "cadeia.h"
+#include "salvamento.h"
+#include "tridiagonal.h"
 /* ---
    Programa escrito durante o ciclo 2024-2025 do PIBIC da UFAL
    para resolver numericamente as equações de movimento de uma rede 1D
@@ -34,74 +62,886 @@
 /* Buffer para a memoria alocada nesta unidade de translacao,
    ele eh inicializado por `preparar_sistema` e aponta para
    uma regiao de memoria liberada por `main`. */
-static double * buffer;
+static real * buffer;
 
 #define SIZE_C(x) ((size_t)(x))
 
 typedef double *double_p;
+typedef real *real_p;
+typedef acumulador *acumulador_p;
 
-static size_t contar_linhas(FILE *arquivo);
+static size_t contar_linhas(const char *texto, size_t tamanho);
 
 /* As grandezas fisicas de relevante interesse sao declaradas
    como variaveis globais, a fim de que sejam acessiveis a partir
-   de qualquer subrotina nessa unidade de translacao. */
+   de qualquer subrotina nessa unidade de translacao.
+   Varias realizacoes da desordem (R arquivos de entrada com o mesmo N)
+   podem ser integradas juntas, nesse caso os vetores sao intercalados:
+   a grandeza do corpo n na realizacao r fica na posicao n * R + r,
+   de modo que os nucleos vetorizam ao longo das realizacoes. */
 static size_t N; /* numero de corpos oscilando */
-static double t; /* variavel independente */
-static double_p massa, kappa; /* parametros */
-static double_p Q, P; /* variaveis dependentes */
-static double E; /* energia do sistema */
+static size_t R; /* numero de realizacoes */
+static real_p massa, kappa; /* parametros */
+static real_p inv_massa; /* 1 / massa, evita a divisao em `dot_Q` */
+static real_p Q, P; /* variaveis dependentes */
+static acumulador_p E; /* energia inicial e atual de cada realizacao */
+static FILE **saida; /* onde cada realizacao eh escrita */
+static unsigned char *ativa; /* realizacoes que ainda conservam a energia */
+static int binario = -1; /* descritor da trajetoria binaria (opcao -b) */
 
-/* componentes do campo vetorial hamiltoniano */
-static double dot_Q(size_t n, double *P);
-static double dot_P(size_t n, double *Q);
-static double hamiltoniano(void);
+/* A conservacao da energia eh conferida a cada `intervalo_monitor` de
+   tempo (opcao -e, por padrao o intervalo entre escritas da opcao -i)
+   pelo desvio relativo (H - E) / |E|. A realizacao cujo desvio passa de
+   `tolerancia` (opcao -t, 0 apenas registra) deixa de ser escrita. Com a
+   opcao -m o desvio de todas as realizacoes em cada conferencia eh
+   registrado num arquivo. */
+static double intervalo_monitor = 0.0;
+static double tolerancia = 1.0e-6;
+static FILE *deriva;
 
-static int preparar_sistema(char *nome_arquivo);
-static int escrever(double t);
+/* Com a opcao -o, no lugar do estado completo, cada escrita produz uma
+   linha com alguns observaveis da distribuicao de energia
+      e_n = P_n^2 / 2 m_n + kappa_n-1 (Q_n - Q_n-1)^2 / 4
+          + kappa_n (Q_n+1 - Q_n)^2 / 4,
+   na ordem em que foram pedidos. O ultimo corpo fica com toda a energia
+   da mola presa a parede, de modo que a soma dos e_n eh a energia. */
+enum {
+   ENERGIA, /* soma de e_n */
+   CENTRO, /* centroide da energia, sum n e_n / E */
+   ESPALHAMENTO, /* segundo momento, sum (n - centro)^2 e_n / E */
+   PARTICIPACAO, /* numero de participacao, E^2 / sum e_n^2 */
+   ESQUERDA, /* e_0 */
+   DIREITA, /* e_N-1 */
+   OBSERVAVEIS
+};
+static const char *const nomes_observaveis[OBSERVAVEIS] = {
+   "energia", "centro", "espalhamento", "participacao", "esquerda", "direita"
+};
+static int observaveis[2 * OBSERVAVEIS]; /* os pedidos, em ordem */
+static size_t K; /* quantos foram pedidos, 0 escreve o estado completo */
+static acumulador_p observados; /* K observaveis de cada realizacao */
+static acumulador_p somas; /* somas parciais de `medir` */
 
-#undef PVI_FAC_ALIQUID
-#define PVI_FAC_ALIQUID() {\
-   ++i; \
-   if(i < i_max) continue;\
-   i = 0; \
-   if(escrever(t) != 0) break;\
+/* A escrita eh feita por um fio de execucao separado. Em cada instante de
+   escrita o integrador copia o estado para um dos dois quadros e segue
+   adiante, enquanto o escritor esvazia o outro. Se o escritor estiver
+   atrasado o integrador espera, ou, com a opcao -d, descarta o quadro. */
+typedef struct {
+   double t;
+   double_p Q, P;
+   double_p O; /* K observaveis de cada realizacao, com a opcao -o */
+   unsigned char *ativa;
+} quadro;
+
+static struct {
+   pthread_t fio;
+   pthread_mutex_t trava;
+   pthread_cond_t sinal;
+   quadro quadros[2];
+   int cheio[2]; /* quadro pronto para ser escrito */
+   int proximo; /* quadro que o integrador preenche a seguir */
+   int fim, erro, descartar;
+   unsigned long descartados;
+} escritor = {
+   .trava = PTHREAD_MUTEX_INITIALIZER,
+   .sinal = PTHREAD_COND_INITIALIZER
+};
+
+/* parametros do campo vetorial (ver rede.h) */
+static rede parametros;
+
+/* Instrumentacao, compilada so com -DCLASSICO_PERFIL: sem ela as macros
+   PERFIL_* somem e a execucao nao paga nada. O tempo de parede
+   (CLOCK_MONOTONIC) vai para uma fase de cada vez, PERFIL_ENTRAR empilha
+   uma fase e PERFIL_SAIR volta a anterior, entao `medir` chamado dentro
+   de um passo nao conta como passo. Quando perf_event_open esta
+   disponivel, os ciclos e as faltas na ultima cache do fio principal
+   tambem vao para as fases; o escritor, que roda em paralelo, so tem o
+   seu tempo e os bytes escritos. O relatorio vai para a saida de erro ao
+   fim da execucao e, com CLASSICO_PERFIL=texto,K ou CLASSICO_PERFIL=json,K
+   no ambiente, tambem a cada K quadros entregues. */
+#ifdef CLASSICO_PERFIL
+enum {
+   FASE_OUTROS, FASE_LEITURA, FASE_MODOS, FASE_PASSOS, FASE_INTERPOLACAO,
+   FASE_MEDIDA, FASE_ENTREGA, FASE_ESPERA, FASE_SALVAMENTO, FASE_ESCRITA,
+   FASES
+};
+static const char *const nomes_fases[FASES] = {
+   "outros", "leitura", "modos", "passos", "interpolacao", "medida",
+   "entrega", "espera", "salvamento", "escrita"
+};
+static struct {
+   double inicio, marca, tempo[FASES];
+   uint64_t contadores[2], eventos[2][FASES]; /* ciclos e faltas */
+   int descritores[2]; /* -1 sem o contador */
+   int pilha[8], topo;
+   int json;
+   unsigned long a_cada, quadros, conferencias, salvamentos;
+   unsigned long passos, avaliacoes, avaliacoes_atuais;
+   double corpos; /* soma dos corpos ativos de cada passo */
+   uint64_t bytes; /* escritos pelo escritor */
+   uint64_t bytes_quadro; /* so o escritor mexe */
+   double inicio_quadro;
+} perfil;
+static void perfil_iniciar(void);
+static void perfil_entrar(int fase);
+static void perfil_sair(void);
+static void perfil_quadro(void);
+static double perfil_agora(void);
+#define PERFIL_INICIAR() perfil_iniciar()
+#define PERFIL_ENTRAR(fase) perfil_entrar(fase)
+#define PERFIL_SAIR() perfil_sair()
+#define PERFIL_SOMAR(campo, x) (perfil.campo += (x))
+#define PERFIL_QUADRO() perfil_quadro()
+#define PERFIL_PASSO(contexto) {\
+   ++perfil.passos;\
+   perfil.corpos += (double)((ultimo - primeiro) * R);\
+   perfil.avaliacoes_atuais = (contexto)->evaluationes;\
+}
+/* o contexto guarda as avaliacoes so ate ser destruido */
+#define PERFIL_CONTEXTO_FIM(contexto) if((contexto) != NULL){\
+   perfil.avaliacoes += (contexto)->evaluationes;\
+   perfil.avaliacoes_atuais = 0UL;\
+}
+/* `n` eh o retorno de fprintf ou o tamanho de uma escrita binaria */
+#define PERFIL_BYTES(n) perfil_bytes((long long)(n))
+static void perfil_bytes(long long n){
+   if(n > 0) perfil.bytes_quadro += (uint64_t)n;
+}
+/* no escritor, em volta de `escrever_quadro`; o fim ja com a trava */
+#define PERFIL_ESCRITA_INICIO() (perfil.inicio_quadro = perfil_agora())
+#define PERFIL_ESCRITA_FIM() {\
+   perfil.tempo[FASE_ESCRITA] += perfil_agora() - perfil.inicio_quadro;\
+   perfil.bytes += perfil.bytes_quadro;\
+   perfil.bytes_quadro = UINT64_C(0);\
 }
+#else
+#define PERFIL_INICIAR()
+#define PERFIL_ENTRAR(fase)
+#define PERFIL_SAIR()
+#define PERFIL_SOMAR(campo, x)
+#define PERFIL_QUADRO()
+#define PERFIL_PASSO(contexto)
+#define PERFIL_CONTEXTO_FIM(contexto)
+#define PERFIL_BYTES(n) (void)(n)
+#define PERFIL_ESCRITA_INICIO()
+#define PERFIL_ESCRITA_FIM()
+#endif
 
-int main(int argc, char **argv){
-   unsigned i, i_max;
-   double *buffer;
-   FILE *arquivo;
+static void medir(acumulador *H, acumulador *O);
+static int escolher_observaveis(char *lista);
+
+/* nucleos de `dot_Q` e `dot_P` escolhidos ao iniciar (ver rede.h) e o
+   seu indice em `nomes_nucleos` */
+static nucleo arrastar, chutar;
+static int nivel_nucleos;
+
+/* Com a opcao -n a integracao passo a passo da lugar aos modos normais:
+   como a rede eh linear, a matriz dinamica M^-1/2 K M^-1/2 de cada
+   realizacao eh diagonalizada uma unica vez (ver tridiagonal.h) e o
+   estado em cada instante de escrita eh a soma dos modos com as suas
+   fases, sem erro de truncamento e com um custo O(N^2) por escrita que
+   nao depende de t. Com a opcao -p a frequencia e o numero de
+   participacao de cada modo sao escritos num arquivo, com ou sem -n. */
+static int modos_normais = 0;
+static FILE *espectro;
+static double_p modos; /* R matrizes N x N, a linha k eh o modo k */
+static double_p frequencias; /* omega_k da realizacao r em r * N + k */
+static double_p amplitudes; /* a_k e b_k da realizacao r a partir de 2rN */
+static double_p coeficientes; /* 2N, os pesos dos modos num instante */
+static int diagonalizar(void);
+static void curre_modos(void);
+
+/* Salvamento do estado na opcao -c: a cada `intervalo_salvamento`
+   segundos de relogio (opcao -w) e quando chegam os sinais SIGUSR1, que
+   salva e segue, ou SIGTERM, que salva e para. Com a opcao -r a execucao
+   segue do estado salvo, com os mesmos bits que teria sem a interrupcao,
+   em vez de ler as realizacoes (ver salvamento.h). */
+static char *nome_salvamento;
+static int restaurar = 0;
+static double intervalo_salvamento = 0.0;
+static time_t ultimo_salvamento;
+static volatile sig_atomic_t pedido_salvar = 0, pedido_parar = 0;
+static cabecalho_salvamento salvo; /* o estado lido com a opcao -r */
+static int salvar_estado(const pvi_contextus *contexto);
+static int ler_estado(char **nome_arquivo);
+
+/* Com a opcao -j a integracao fica restrita aos corpos [primeiro, ultimo),
+   fora dos quais a rede ainda esta parada (Q = P = 0) e faz o papel das
+   paredes. Depois de cada passo sao olhados os JANELA_MARGEM corpos de
+   cada ponta, e o lado em que algum |Q| ou |P| passar de `limiar` dobra
+   de largura. A margem eh maior que o alcance de um passo (um corpo por
+   subpasso de chute), entao o que fica de fora esta abaixo do limiar e o
+   resultado difere da integracao da rede inteira apenas nessa ordem. Com
+   uma excitacao localizada o custo de cada passo acompanha o seu
+   espalhamento, e nao N. */
+#define JANELA_MARGEM SIZE_C(2 * PVI_STADIA_MAXIMA + 2)
+#define JANELA_CRESCEU 2 /* retorno de `a_cada_passo` */
+static double limiar = 0.0;
+static size_t primeiro, ultimo;
+static void iniciar_janela(void);
+static int alargar_janela(void);
+static pvi_contextus *criar_contexto(int esquema, double h, double t);
+static int curre(pvi_contextus *contexto);
+static void pedir_salvamento(int numero){
+   if(numero == SIGTERM) pedido_parar = 1;
+   pedido_salvar = 1;
+}
+
+static int preparar_sistema(char **nome_arquivo, size_t realizacoes);
+static int abrir_saida(const char *nome_arquivo, size_t r);
+static const char *repetido(char **nome_arquivo, size_t realizacoes);
+static int escrever(double t, int conferir);
+static int monitorar(double t);
+static int escrever_cabecalho(double h, double intervalo);
+static int iniciar_escritor(void);
+static int terminar_escritor(void);
+static void liberar_sistema(void);
+
+/* Os instantes de escrita nao dependem do passo: sao os multiplos de
+   `intervalo_escrita` (opcao -i) ou, com a opcao -l, `por_decada`
+   instantes igualmente espacados em log t a partir de intervalo_escrita.
+   O estado num instante que cai dentro de um passo eh interpolado pelo
+   integrador (ver pvi_interpola) e ocupa o lugar de Q e P durante a
+   escrita, por isso tem as mesmas bordas nulas. */
+static double intervalo_escrita = 0.5, tempo_final;
+static unsigned long por_decada = 0UL;
+static unsigned long escrita = 1UL; /* indice do proximo instante */
+static real *interpolados;
+static real_p Q_interpolado, P_interpolado;
+static double instante(unsigned long k){
+   if(por_decada == 0UL) return (double)k * intervalo_escrita;
+   return intervalo_escrita *
+      pow(10.0, (double)(k - 1UL) / (double)por_decada);
+}
+static int escrever_interpolado(pvi_contextus *contexto, double t){
+   real_p q = Q, p = P;
    int status;
 
+   if(interpolados == NULL){
+      interpolados = calloc(2 * N * R + 2 * R, sizeof(*interpolados));
+      if(interpolados == NULL){
+         fputs(
+            "ERRO: "
+            "N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente mem" "\xC3\xB3" "ria.\n",
+            stderr
+         );
+         return 1;
+      }
+      Q_interpolado = interpolados + R;
+      P_interpolado = interpolados + N * R + 2 * R;
+   }
+   PERFIL_ENTRAR(FASE_INTERPOLACAO);
+   status = pvi_interpola(contexto, t, Q_interpolado + primeiro * R,
+      P_interpolado + primeiro * R);
+   PERFIL_SAIR();
+   if(status != 0) return 1;
+   Q = Q_interpolado;
+   P = P_interpolado;
+   status = escrever(t, 0);
+   Q = q;
+   P = p;
+   return status;
+}
+
+/* Chamada pelo integrador depois de cada passo, escreve e confere a
+   energia nos instantes devidos. O monitor so olha o fim dos passos, onde
+   o estado nao tem o erro da interpolacao. Um valor diferente de 0
+   interrompe a integracao, JANELA_CRESCEU para que o contexto seja
+   refeito para a nova janela. */
+static unsigned long passo, passos_monitor;
+static int a_cada_passo(pvi_contextus *contexto){
+   const double t = contexto->tempus;
+   int conferir, status, crescer;
+   double proximo;
+
+   ++passo;
+   PERFIL_PASSO(contexto);
+   conferir = (passo % passos_monitor == 0UL);
+   for(; (proximo = instante(escrita)) <= t; ++escrita){
+      if(proximo > tempo_final) break;
+      if(proximo == t){
+         status = escrever(t, conferir);
+         conferir = 0;
+      }else{
+         status = escrever_interpolado(contexto, proximo);
+      }
+      if(status != 0) return status;
+   }
+   /* o passo seguinte so eh guardado se tiver alguma escrita */
+   contexto->densus = (proximo <= t + contexto->h);
+   if(conferir && (status = monitorar(t)) != 0) return status;
+   /* a janela cresce antes do salvamento, que ja guarda a nova */
+   crescer = (limiar > 0.0 && alargar_janela());
+
+   /* o estado eh salvo no fim do passo, depois das escritas */
+   if(nome_salvamento != NULL && (pedido_salvar || (intervalo_salvamento > 0.0
+      && difftime(time(NULL), ultimo_salvamento) >= intervalo_salvamento))){
+      pedido_salvar = 0;
+      PERFIL_ENTRAR(FASE_SALVAMENTO);
+      status = salvar_estado(contexto);
+      PERFIL_SAIR();
+      PERFIL_SOMAR(salvamentos, 1UL);
+      ultimo_salvamento = time(NULL);
+      /* a falha de um salvamento periodico apenas eh avisada */
+      if(pedido_parar){
+         if(status == 0)
+            fprintf(stderr, "Estado salvo em %s (t = %g).\n",
+               nome_salvamento, t);
+         return 1;
+      }
+   }
+   return (crescer ? JANELA_CRESCEU : 0);
+}
+
+int main(int argc, char **argv){
+   pvi_contextus *contexto;
+   struct sigaction acao;
+   double h, t;
+   int status, opcao, esquema = PVI_RUTH4, interrompida;
+   char **arquivos, *programa = argv[0];
+   const char *nome_trajetoria = NULL, *nome_deriva = NULL, *nome;
+   size_t realizacoes = SIZE_C(1);
+
+   /* as realizacoes adicionais sao dadas por `-a arquivo`,
+      `-b arquivo` escreve a trajetoria em binario (ver trajetoria.h),
+      `-o lista` escreve apenas os observaveis da lista e
+      `-e intervalo`, `-t tolerancia` e `-m arquivo` ajustam o monitor
+      da energia, `-s esquema` escolhe o metodo simpletico, `-i intervalo`
+      eh o tempo entre duas escritas e `-l pontos` faz as escritas
+      logaritmicas, com tantos pontos por decada, `-n` troca o integrador
+      pelos modos normais e `-p arquivo` escreve o espectro dos modos,
+      `-c arquivo` salva o estado a cada `-w segundos` e nos sinais
+      SIGUSR1 e SIGTERM, `-r` retoma a execucao salva nele e `-j limiar`
+      integra apenas a janela ativa em torno da excitacao */
+   arquivos = malloc((size_t)argc * sizeof(*arquivos));
+   if(arquivos == NULL) return EXIT_FAILURE;
+   while((opcao = getopt(argc, argv, "a:b:c:de:i:j:l:m:no:p:rs:t:w:")) != -1){
+      if(opcao == 'a'){
+         arquivos[realizacoes++] = optarg;
+         continue;
+      }
+      if(opcao == 'd'){
+         escritor.descartar = 1;
+         continue;
+      }
+      if(opcao == 'n'){
+         modos_normais = 1;
+         continue;
+      }
+      if(opcao == 'r'){
+         restaurar = 1;
+         continue;
+      }
+      if(opcao == 'c'){
+         nome_salvamento = optarg;
+         continue;
+      }
+      if(opcao == 'b' && nome_trajetoria == NULL){
+         nome_trajetoria = optarg;
+         continue;
+      }
+      if(opcao == 'm' && nome_deriva == NULL){
+         nome_deriva = optarg;
+         continue;
+      }
+      if(opcao == 'e'){
+         intervalo_monitor = atof(optarg);
+         continue;
+      }
+      if(opcao == 't'){
+         tolerancia = atof(optarg);
+         continue;
+      }
+      if(opcao == 'i' && (intervalo_escrita = atof(optarg)) > 0.0) continue;
+      if(opcao == 'l' && (por_decada = strtoul(optarg, NULL, 10)) > 0UL)
+         continue;
+      if(opcao == 'w' && (intervalo_salvamento = atof(optarg)) > 0.0)
+         continue;
+      if(opcao == 'j' && (limiar = atof(optarg)) > 0.0) continue;
+      if(opcao == 'i' || opcao == 'l' || opcao == 'w' || opcao == 'j'){
+         fprintf(stderr, "ERRO: Valor inv" "\xC3\xA1" "lido para -%c: "
+            "%s.\n", opcao, optarg);
+      }
+      if(opcao == 'o' && escolher_observaveis(optarg) == 0) continue;
+      if(opcao == 's'){
+         esquema = pvi_methodus(optarg);
+         if(esquema >= PVI_EULER_S) continue;
+         fprintf(stderr, "ERRO: %s n" "\xC3\xA3" "o " "\xC3\xA9" " um "
+            "m" "\xC3\xA9" "todo simpl" "\xC3\xA9" "tico.\n", optarg);
+      }
+      if(opcao == 'p' && espectro == NULL){
+         espectro = fopen(optarg, "w");
+         if(espectro != NULL) continue;
+         fprintf(stderr,
+            "ERRO: N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+            "abrir %s para escrita.\n", optarg);
+      }
+      free(arquivos);
+      liberar_sistema();
+      return EXIT_FAILURE;
+   }
+   argc -= optind - 1;
+   argv += optind - 1;
+   argv[0] = programa;
+   if(K > SIZE_C(0) && nome_trajetoria != NULL){
+      fputs("ERRO: As op" "\xC3\xA7\xC3\xB5" "es -b e -o s" "\xC3\xA3"
+         "o incompat" "\xC3\xAD" "veis.\n", stderr);
+      argc = 0;
+   }
+   if(modos_normais && nome_salvamento != NULL){
+      fputs("ERRO: As op" "\xC3\xA7\xC3\xB5" "es -c e -n s" "\xC3\xA3"
+         "o incompat" "\xC3\xAD" "veis.\n", stderr);
+      argc = 0;
+   }
+   if(restaurar && nome_salvamento == NULL){
+      fputs("ERRO: A op" "\xC3\xA7\xC3\xA3" "o -r precisa da op"
+         "\xC3\xA7\xC3\xA3" "o -c.\n", stderr);
+      argc = 0;
+   }
+
    if(argc < 2){
       fputs("ERRO: Argumentos inv" "\xc3\xa1" "lidos.\n", stderr);
-      fprintf(stderr, "%s [arquivo] <tempo final>\n", argv[0]);
+      fprintf(stderr,
+         "%s [-a arquivo]... [-b arquivo] [-d] [-o observ" "\xC3\xA1" "veis] "
+         "[-e intervalo] [-t toler" "\xC3\xA2" "ncia] [-m arquivo] "
+         "[-s esquema] [-i intervalo] [-l pontos por d" "\xC3\xA9" "cada] "
+         "[-n] [-p arquivo] [-c arquivo] [-w segundos] [-r] [-j limiar] "
+         "[arquivo] <tempo final> <passo>\n", argv[0]);
+      fprintf(stderr, "observ" "\xC3\xA1" "veis: lista separada por "
+         "v" "\xC3\xAD" "rgulas de energia, centro, espalhamento, "
+         "participacao, esquerda, direita e bordas\n");
+      fprintf(stderr, "esquemas: euler_s, verlet, ruth3, ruth4 (padr" "\xC3\xA3"
+         "o), yoshida6, yoshida8, blanes_moan4, blanes_moan6, "
+         "blanes_moan_rkn4, blanes_moan_rkn6, saba2 a saba4 e "
+         "sbab2 a sbab4\n");
+      free(arquivos);
+      liberar_sistema();
+      return EXIT_FAILURE;
+   }
+   arquivos[0] = argv[1];
+   if((nome = repetido(arquivos, realizacoes)) != NULL){
+      fprintf(stderr, "ERRO: %s foi dado mais de uma vez.\n", nome);
+      free(arquivos);
+      liberar_sistema();
+      return EXIT_FAILURE;
+   }
+
+   /* as saidas sao abertas depois de todas as opcoes porque com -r elas
+      continuam de onde o estado foi salvo em vez de recomecar */
+   if(nome_trajetoria != NULL){
+      binario = open(nome_trajetoria,
+         O_WRONLY | O_CREAT | (restaurar ? O_APPEND : O_TRUNC), 0644);
+   }
+   if(nome_deriva != NULL) deriva = fopen(nome_deriva, restaurar ? "a" : "w");
+   if(
+      (nome_trajetoria != NULL && binario < 0) ||
+      (nome_deriva != NULL && deriva == NULL)
+   ){
+      fprintf(stderr,
+         "ERRO: N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+         "abrir %s para escrita.\n",
+         binario < 0 && nome_trajetoria != NULL ? nome_trajetoria : nome_deriva);
+      free(arquivos);
+      liberar_sistema();
       return EXIT_FAILURE;
    }
 
-   status = preparar_sistema(argv[1]);
+   PERFIL_INICIAR();
+   PERFIL_ENTRAR(FASE_LEITURA);
+   status = preparar_sistema(arquivos, realizacoes);
+   PERFIL_SAIR();
+   free(arquivos);
    if(status != EXIT_SUCCESS) return status;
 
    /* Resolver numericamente o PVI */
-   pvi_dimensio = N;
+   h = (argc > 3 ? atof(argv[3]) : 0.5);
+   tempo_final = (argc > 2 ? atof(argv[2]) : 10.0);
+   if(restaurar && (salvo.esquema != (uint32_t)esquema || salvo.h != h)){
+      fprintf(stderr, "ERRO: %s foi salvo com outro esquema ou outro "
+         "passo.\n", nome_salvamento);
+      liberar_sistema();
+      return EXIT_FAILURE;
+   }
 
-   t = 0.0;
-   pvi_h = (argc > 3 ? atof(argv[3]) : 0.5);
-   pvi_finalis = (argc > 2 ? atof(argv[2]) : 10.0);
+   passo = (restaurar ? (unsigned long)salvo.passo : 0UL);
+   // por padrao escreve duas vezes por segundo e confere a cada escrita
+   if(intervalo_monitor <= 0.0) intervalo_monitor = intervalo_escrita;
+   passos_monitor = (unsigned long)(intervalo_monitor / h + 0.5);
+   if(passos_monitor == 0UL) passos_monitor = 1UL;
+   if(deriva != NULL && !restaurar){
+      fprintf(deriva, "# t (H - E) / |E|");
+      if(R > SIZE_C(1)) fprintf(deriva, " de cada realiza" "\xC3\xA7\xC3\xA3" "o");
+      fprintf(deriva, "\n");
+   }
+   if(modos_normais || espectro != NULL){
+      PERFIL_ENTRAR(FASE_MODOS);
+      status = diagonalizar();
+      PERFIL_SAIR();
+      if(status != 0){
+         liberar_sistema();
+         return EXIT_FAILURE;
+      }
+   }
+   if(modos_normais){
+      if(
+         escrever_cabecalho(0.0, por_decada ? 0.0 : intervalo_escrita) != 0 ||
+         iniciar_escritor() != 0
+      ){
+         liberar_sistema();
+         return EXIT_FAILURE;
+      }
+      curre_modos();
+      status = terminar_escritor();
+      liberar_sistema();
+      return status;
+   }
+   nivel_nucleos = escolher_nucleos(&arrastar, &chutar);
+   if(limiar > 0.0 && !restaurar) iniciar_janela();
+   contexto = criar_contexto(esquema, h, restaurar ? salvo.t : 0.0);
+   if(
+      contexto == NULL || (!restaurar &&
+      escrever_cabecalho(h, por_decada ? 0.0 : intervalo_escrita) != 0) ||
+      iniciar_escritor() != 0
+   ){
+      pvi_destrue(contexto);
+      liberar_sistema();
+      return EXIT_FAILURE;
+   }
+   if(nome_salvamento != NULL){
+      memset(&acao, 0, sizeof(acao));
+      acao.sa_handler = pedir_salvamento;
+      acao.sa_flags = SA_RESTART;
+      sigemptyset(&acao.sa_mask);
+      sigaction(SIGTERM, &acao, NULL);
+      sigaction(SIGUSR1, &acao, NULL);
+      ultimo_salvamento = time(NULL);
+   }
+   PERFIL_ENTRAR(FASE_PASSOS);
+   while(
+      (status = curre(contexto)) == JANELA_CRESCEU
+   ){
+      t = contexto->tempus;
+      PERFIL_CONTEXTO_FIM(contexto);
+      pvi_destrue(contexto);
+      contexto = criar_contexto(esquema, h, t);
+      if(contexto == NULL){
+         fputs(
+            "ERRO: "
+            "N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente mem" "\xC3\xB3" "ria.\n",
+            stderr
+         );
+         break;
+      }
+   }
+   /* interrompida por SIGTERM ou sem memoria para a janela, a execucao
+      nao chegou ao fim */
+   PERFIL_SAIR();
+   interrompida = (contexto == NULL || (status != 0 && pedido_parar));
+   PERFIL_CONTEXTO_FIM(contexto);
+   pvi_destrue(contexto);
 
-   i = 0U;
-   i_max = (unsigned)(1.0 / (2.0 * pvi_h)); // escreve duas vezes por segundo
-   PVI_INTEGRATOR_RUTH4(t, Q, P, dot_Q, dot_P);
+   status = terminar_escritor();
+   liberar_sistema();
+   return (interrompida ? EXIT_FAILURE : status);
+}
 
-   free(buffer);
+/* Com OpenMP os pedacos do arquivo de entrada sao lidos em paralelo, e os
+   pedacos da rede em `medir` sao somados em paralelo. */
+#ifdef _OPENMP
+#define PARALELO _Pragma("omp parallel for schedule(dynamic)")
+#else
+#define PARALELO
+#endif
+#define MEDIR_PEDACO SIZE_C(4096)
+
+static int alocar_sistema(size_t linhas, char *nome_arquivo, size_t r){
+   if(r == SIZE_C(0)){
+      N = linhas;
+      buffer = malloc((5 * N * R + 3 * R) * sizeof(*buffer));
+      if(buffer == NULL){
+         fputs(
+            "ERRO: "
+            "N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente mem" "\xC3\xB3" "ria.\n",
+            stderr
+         );
+         return EXIT_FAILURE;
+      }
+      massa = buffer;
+      kappa = buffer + N*R + R;
+      Q = buffer + 2*N*R + 2*R;
+      P = buffer + 3*N*R + 3*R;
+      inv_massa = buffer + 4*N*R + 3*R;
+   }else if(linhas != N){
+      fprintf(stderr,
+         "ERRO: %s n" "\xC3\xA3" "o tem o mesmo n" "\xC3\xBA" "mero "
+         "de corpos que %s.\n", nome_arquivo, "a primeira realiza"
+         "\xC3\xA7\xC3\xA3" "o");
+      return EXIT_FAILURE;
+   }
+   kappa[r - R] = 0.0;
+   Q[r - R] = Q[N*R + r] = 0.0;
    return EXIT_SUCCESS;
 }
 
-static int preparar_sistema(char *nome_arquivo){
-   FILE *arquivo;
+/* Leitor de numeros em ponto flutuante. Quando a mantissa decimal cabe
+   em 53 bits e o expoente decimal nao passa de 22, tanto a mantissa
+   quanto a potencia de 10 sao exatas e uma unica operacao da o double
+   corretamente arredondado (Clinger, 1990). Com o long double de 64 bits
+   do x87 o mesmo vale para mantissas de ate 19 algarismos e expoentes de
+   ate 27, desde que o resultado nao caia perto do ponto medio entre dois
+   doubles, quando o duplo arredondamento poderia errar. Nos demais casos
+   (mais de 19 algarismos, expoentes grandes, inf, nan, hexadecimais) o
+   numero vai para `strtod`. Portanto o resultado eh sempre igual ao de `strtod`. */
+static const double potencias_de_10[] = {
+   1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#if (defined(__x86_64__) || defined(__i386__)) && LDBL_MANT_DIG == 64
+#define LONG_DOUBLE_X87 1
+static const long double potencias_de_10_longas[] = {
+   1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L, 1e9L, 1e10L,
+   1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L, 1e20L,
+   1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L
+};
+#endif
+
+#define ALGARISMO(c) ((unsigned)((c) - '0') < 10U)
+#define ESPACO(c) ((c) == ' ' || (c) == '\t' || (c) == '\r')
+
+static const char *ler_numero(const char *p, const char *fim, double *x){
+   const char *inicio = p;
+   uint64_t mantissa = UINT64_C(0);
+   int significativos = 0, expoente = 0, algarismos = 0, exato = 1;
+   int negativo = 0, terminado;
+
+   if(p < fim && (*p == '-' || *p == '+')) negativo = (*p++ == '-');
+   for(; p < fim && ALGARISMO(*p); ++p, ++algarismos){
+      if(significativos < 19){
+         mantissa = 10U * mantissa + (unsigned)(*p - '0');
+         if(mantissa != UINT64_C(0)) ++significativos;
+      }else{
+         ++expoente;
+         if(*p != '0') exato = 0;
+      }
+   }
+   if(p < fim && *p == '.'){
+      for(++p; p < fim && ALGARISMO(*p); ++p, ++algarismos){
+         if(significativos < 19){
+            mantissa = 10U * mantissa + (unsigned)(*p - '0');
+            if(mantissa != UINT64_C(0)) ++significativos;
+            --expoente;
+         }else if(*p != '0'){
+            exato = 0;
+         }
+      }
+   }
+   if(algarismos > 0 && p < fim && (*p == 'e' || *p == 'E')){
+      int e = 0, negativo_e = 0;
+      ++p;
+      if(p < fim && (*p == '-' || *p == '+')) negativo_e = (*p++ == '-');
+      if(p >= fim || !ALGARISMO(*p)) return NULL;
+      for(; p < fim && ALGARISMO(*p); ++p)
+         if(e < 100000) e = 10 * e + (*p - '0');
+      expoente += negativo_e ? -e : e;
+   }
+   /* o que nao termina aqui (0x1p-3, por exemplo) fica para `strtod` */
+   terminado = (p == fim || ESPACO(*p) || *p == '\n');
+
+   if(
+      terminado && algarismos > 0 && exato &&
+      mantissa <= (UINT64_C(1) << 53) && expoente >= -22 && expoente <= 22
+   ){
+      *x = (double)mantissa;
+      if(expoente < 0) *x /= potencias_de_10[-expoente];
+      else *x *= potencias_de_10[expoente];
+      if(negativo) *x = -*x;
+      return p;
+   }
+#ifdef LONG_DOUBLE_X87
+   if(
+      terminado && algarismos > 0 && exato &&
+      expoente >= -27 && expoente <= 27
+   ){
+      long double y = (long double)mantissa;
+      uint64_t bits;
+      if(expoente < 0) y /= potencias_de_10_longas[-expoente];
+      else y *= potencias_de_10_longas[expoente];
+      /* os 11 bits que o double descarta, longe de 0x400 o arredondamento
+         de long double para double coincide com o arredondamento direto */
+      memcpy(&bits, &y, sizeof(bits));
+      bits &= UINT64_C(0x7FF);
+      if(bits < UINT64_C(0x3FF) || bits > UINT64_C(0x401)){
+         *x = (double)y;
+         if(negativo) *x = -*x;
+         return p;
+      }
+   }
+#endif
+
+   /* caminho lento, o numero eh copiado para terminar com '\0' */
+   {
+      char copia[512], *final;
+      while(p < fim && !ESPACO(*p) && *p != '\n') ++p;
+      if((size_t)(p - inicio) >= sizeof(copia) || p == inicio) return NULL;
+      memcpy(copia, inicio, (size_t)(p - inicio));
+      copia[p - inicio] = '\0';
+      *x = strtod(copia, &final);
+      if(*final != '\0') return NULL;
+   }
+   return p;
+}
+
+/* Le as linhas de [p, fim), a primeira delas eh a linha `n` do arquivo.
+   Retorna 0 ou o numero (a partir de 1) da primeira linha mal formada. */
+static size_t ler_linhas(const char *p, const char *fim, size_t n, size_t r){
+   double x[4];
+   size_t k;
+
+   for(; p < fim; ++n){
+      for(int coluna = 0; coluna < 4; ++coluna){
+         while(p < fim && ESPACO(*p)) ++p;
+         p = ler_numero(p, fim, x + coluna);
+         if(p == NULL || (p < fim && !ESPACO(*p) && *p != '\n'))
+            return n + SIZE_C(1);
+      }
+      while(p < fim && ESPACO(*p)) ++p;
+      if(p < fim && *p++ != '\n') return n + SIZE_C(1);
+
+      k = n * R + r;
+      massa[k] = x[0];
+      kappa[k] = x[1];
+      Q[k] = x[2];
+      P[k] = x[3];
+      inv_massa[k] = 1.0 / massa[k];
+   }
+   return SIZE_C(0);
+}
 
-   arquivo = fopen(nome_arquivo, "rb");
-   if(arquivo == NULL){
+/* por hipotese o arquivo deve conter N linhas com quatro colunas cada:
+   * a primeira coluna deve conter o valor da massa do corpo;
+   * a segunda deve conter o valor da constante de acoplamento harmonico
+     entre o corpo e o seguinte vizinho;
+   * a terceira o valor inicial do deslocamento do corpo;
+   * a quarta o valor inicial do momento linear do corpo.
+   O arquivo eh dividido em pedacos que terminam em fim de linha, as linhas
+   de cada pedaco sao contadas e depois lidas de forma independente. */
+static int ler_texto(const char *texto, size_t tamanho,
+   char *nome_arquivo, size_t r){
+   size_t pedacos, j, *inicio, *primeira, *erro, ruim;
+   const char *quebra;
+   int status = EXIT_FAILURE;
+
+   pedacos = tamanho / SIZE_C(262144) + SIZE_C(1);
+   if(pedacos > SIZE_C(4096)) pedacos = SIZE_C(4096);
+   inicio = malloc(3 * (pedacos + 1) * sizeof(*inicio));
+   if(inicio == NULL) return EXIT_FAILURE;
+   primeira = inicio + pedacos + 1;
+   erro = primeira + pedacos + 1;
+
+   inicio[0] = SIZE_C(0);
+   for(j = SIZE_C(1); j <= pedacos; ++j){
+      inicio[j] = j * (tamanho / pedacos);
+      if(j == pedacos || inicio[j] <= inicio[j-1]){
+         inicio[j] = (j == pedacos ? tamanho : inicio[j-1]);
+         continue;
+      }
+      quebra = memchr(texto + inicio[j] - 1, '\n', tamanho - inicio[j] + 1);
+      inicio[j] = (quebra == NULL ? tamanho : (size_t)(quebra - texto) + 1);
+   }
+
+   PARALELO for(j = SIZE_C(0); j < pedacos; ++j)
+      primeira[j+1] = contar_linhas(texto + inicio[j], inicio[j+1] - inicio[j]);
+   primeira[0] = SIZE_C(0);
+   for(j = SIZE_C(1); j <= pedacos; ++j) primeira[j] += primeira[j-1];
+
+   if(primeira[pedacos] == SIZE_C(0)){
+      fprintf(stderr, "ERRO: %s n" "\xC3\xA3" "o descreve nenhum corpo.\n",
+         nome_arquivo);
+      goto fim;
+   }
+   if(alocar_sistema(primeira[pedacos], nome_arquivo, r) != EXIT_SUCCESS)
+      goto fim;
+
+   PARALELO for(j = SIZE_C(0); j < pedacos; ++j){
+      erro[j] = ler_linhas(
+         texto + inicio[j], texto + inicio[j+1], primeira[j], r
+      );
+   }
+   for(j = SIZE_C(0), ruim = SIZE_C(0); j < pedacos && ruim == 0; ++j)
+      ruim = erro[j];
+   if(ruim != SIZE_C(0)){
+      fprintf(stderr, "ERRO: A linha %zu de %s n" "\xC3\xA3" "o tem "
+         "quatro n" "\xC3\xBA" "meros.\n", ruim, nome_arquivo);
+      goto fim;
+   }
+   status = EXIT_SUCCESS;
+
+   fim:
+   free(inicio);
+   return status;
+}
+
+static int ler_binario(const char *conteudo, size_t tamanho,
+   char *nome_arquivo, size_t r){
+   cabecalho_cadeia cabecalho;
+   const double *coluna;
+   size_t n, k, linhas;
+
+   memcpy(&cabecalho, conteudo, sizeof(cabecalho));
+   linhas = (size_t)cabecalho.N;
+   if(
+      cabecalho.versao != CADEIA_VERSAO || cabecalho.tipo != CADEIA_DOUBLE ||
+      linhas == SIZE_C(0) ||
+      tamanho != sizeof(cabecalho) + 4 * linhas * sizeof(double)
+   ){
+      fprintf(stderr, "ERRO: %s n" "\xC3\xA3" "o " "\xC3\xA9" " uma "
+         "cadeia bin" "\xC3\xA1" "ria v" "\xC3\xA1" "lida.\n", nome_arquivo);
+      return EXIT_FAILURE;
+   }
+   if(alocar_sistema(linhas, nome_arquivo, r) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+   coluna = (const double*)(conteudo + sizeof(cabecalho));
+   for(n = SIZE_C(0); n < N; ++n){
+      k = n * R + r;
+      massa[k] = coluna[n];
+      kappa[k] = coluna[N + n];
+      Q[k] = coluna[2*N + n];
+      P[k] = coluna[3*N + n];
+      inv_massa[k] = 1.0 / massa[k];
+   }
+   return EXIT_SUCCESS;
+}
+
+/* O arquivo eh mapeado na memoria, se ele comecar com CADEIA_MAGICA
+   eh lido no formato binario (ver cadeia.h), se nao no formato texto. */
+static int ler_realizacao(char *nome_arquivo, size_t r){
+   struct stat informacao;
+   char *conteudo;
+   int arquivo, status;
+
+   arquivo = open(nome_arquivo, O_RDONLY);
+   if(arquivo < 0){
+      fputs(
+         "ERRO: "
+         "N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+         "abrir o arquivo para leitura.\n",
+         stderr
+      );
+      return EXIT_FAILURE;
+   }
+   if(fstat(arquivo, &informacao) != 0 || informacao.st_size <= 0){
+      fprintf(stderr, "ERRO: %s n" "\xC3\xA3" "o descreve nenhum corpo.\n",
+         nome_arquivo);
+      close(arquivo);
+      return EXIT_FAILURE;
+   }
+   conteudo = mmap(
+      NULL, (size_t)informacao.st_size, PROT_READ, MAP_PRIVATE, arquivo, 0
+   );
+   close(arquivo);
+   if(conteudo == MAP_FAILED){
       fputs(
          "ERRO: "
          "N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
@@ -110,97 +950,1187 @@ static int preparar_sistema(char *nome_arquivo){
       );
       return EXIT_FAILURE;
    }
+   posix_madvise(conteudo, (size_t)informacao.st_size, POSIX_MADV_SEQUENTIAL);
+
+   if(
+      (size_t)informacao.st_size >= sizeof(cabecalho_cadeia) &&
+      memcmp(conteudo, CADEIA_MAGICA, sizeof(CADEIA_MAGICA)) == 0
+   ){
+      status = ler_binario(
+         conteudo, (size_t)informacao.st_size, nome_arquivo, r
+      );
+   }else{
+      status = ler_texto(
+         conteudo, (size_t)informacao.st_size, nome_arquivo, r
+      );
+   }
+   munmap(conteudo, (size_t)informacao.st_size);
+   if(status != EXIT_SUCCESS) return status;
+   ativa[r] = 1;
+   return abrir_saida(nome_arquivo, r);
+}
+
+/* Com uma so realizacao a saida eh a saida padrao, com varias cada
+   uma eh escrita em `arquivo.saida`, que continua com a opcao -r. */
+static int abrir_saida(const char *nome_arquivo, size_t r){
+   if(binario >= 0){
+      saida[r] = NULL;
+   }else if(R == SIZE_C(1)){
+      saida[r] = stdout;
+   }else{
+      char *nome = malloc(strlen(nome_arquivo) + sizeof(".saida"));
+      if(nome == NULL) return EXIT_FAILURE;
+      strcpy(nome, nome_arquivo);
+      strcat(nome, ".saida");
+      saida[r] = fopen(nome, restaurar ? "a" : "w");
+      if(saida[r] == NULL){
+         fprintf(stderr,
+            "ERRO: N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+            "abrir %s para escrita.\n", nome);
+         free(nome);
+         return EXIT_FAILURE;
+      }
+      free(nome);
+   }
+
+   return EXIT_SUCCESS;
+}
 
-   N = contar_linhas(arquivo);
+/* Devolve o primeiro arquivo de realizacao que repete um anterior, pelo
+   nome ou, quando os dois existem, pelo dispositivo e inode, ou NULL.
+   As duas realizacoes escreveriam no mesmo `arquivo.saida`. */
+static const char *repetido(char **nome_arquivo, size_t realizacoes){
+   struct stat *estado;
+   unsigned char *existe;
+   const char *nome = NULL;
+   size_t r, q;
 
-   buffer = malloc((4 * N + 3) * sizeof(*buffer));
-   if(buffer == NULL){
+   if(realizacoes < SIZE_C(2)) return NULL;
+   estado = malloc(realizacoes * sizeof(*estado));
+   existe = malloc(realizacoes);
+   for(r = SIZE_C(0); r < realizacoes && nome == NULL; ++r){
+      if(estado != NULL && existe != NULL)
+         existe[r] = (stat(nome_arquivo[r], estado + r) == 0);
+      for(q = SIZE_C(0); q < r && nome == NULL; ++q){
+         if(
+            strcmp(nome_arquivo[q], nome_arquivo[r]) == 0 || (
+               estado != NULL && existe != NULL && existe[q] && existe[r] &&
+               estado[q].st_dev == estado[r].st_dev &&
+               estado[q].st_ino == estado[r].st_ino
+            )
+         ) nome = nome_arquivo[r];
+      }
+   }
+   free(estado);
+   free(existe);
+   return nome;
+}
+
+/* Leitura de todos os bytes pedidos por `iov`, como em `escrever_tudo`. */
+static int ler_tudo(int fd, struct iovec *iov, int quantos){
+   ssize_t lidos;
+
+   while(quantos > 0){
+      lidos = readv(fd, iov, quantos);
+      if(lidos <= 0) return 1;
+      for(; quantos > 0 && (size_t)lidos >= iov->iov_len; ++iov, --quantos)
+         lidos -= (ssize_t)iov->iov_len;
+      if(quantos > 0){
+         iov->iov_base = (char*)iov->iov_base + lidos;
+         iov->iov_len -= (size_t)lidos;
+      }
+   }
+   return 0;
+}
+
+/* Descarta o que foi escrito num arquivo de saida depois do salvamento.
+   Um arquivo menor (a saida padrao recriada pelo shell, por exemplo)
+   apenas segue do fim. */
+static void retomar_arquivo(int fd, uint64_t tamanho){
+   struct stat informacao;
+
+   if(
+      fd < 0 || tamanho == SALVAMENTO_SEM_TAMANHO ||
+      fstat(fd, &informacao) != 0 || !S_ISREG(informacao.st_mode) ||
+      (uint64_t)informacao.st_size < tamanho
+   ) return;
+   if(ftruncate(fd, (off_t)tamanho) == 0) lseek(fd, 0, SEEK_END);
+}
+
+/* Le o estado salvo por `salvar_estado` no lugar das realizacoes, os
+   arquivos das realizacoes dao apenas os nomes das saidas. */
+static int ler_estado(char **nome_arquivo){
+   struct stat informacao;
+   struct iovec iov[4];
+   uint64_t *tamanhos = NULL;
+   size_t r, k;
+   int arquivo, status = EXIT_FAILURE;
+
+   arquivo = open(nome_salvamento, O_RDONLY);
+   if(arquivo < 0){
+      fprintf(stderr,
+         "ERRO: N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+         "abrir %s para leitura.\n", nome_salvamento);
+      return EXIT_FAILURE;
+   }
+   iov[0].iov_base = &salvo;
+   iov[0].iov_len = sizeof(salvo);
+   if(
+      fstat(arquivo, &informacao) != 0 || ler_tudo(arquivo, iov, 1) != 0 ||
+      memcmp(salvo.magica, SALVAMENTO_MAGICA, sizeof(SALVAMENTO_MAGICA)) ||
+      salvo.versao != SALVAMENTO_VERSAO ||
+      salvo.N == UINT64_C(0) || salvo.R == UINT64_C(0) ||
+      salvo.primeiro >= salvo.ultimo || salvo.ultimo > salvo.N
+   ){
+      fprintf(stderr, "ERRO: %s n" "\xC3\xA3" "o " "\xC3\xA9" " um "
+         "estado salvo v" "\xC3\xA1" "lido.\n", nome_salvamento);
+      close(arquivo);
+      return EXIT_FAILURE;
+   }
+   if(salvo.tipo != sizeof(real) || salvo.mantissa != REAL_MANTISSA){
+      fprintf(stderr, "ERRO: %s foi salvo com outra precis" "\xC3\xA3" "o "
+         "(%u bits de mantissa em vez de %d).\n", nome_salvamento,
+         (unsigned)salvo.mantissa, REAL_MANTISSA);
+      close(arquivo);
+      return EXIT_FAILURE;
+   }
+   if((uint64_t)informacao.st_size != sizeof(salvo) + salvo.R * (
+      sizeof(*E) + sizeof(uint64_t) + sizeof(*ativa) +
+      (4 * salvo.N + 3) * sizeof(*buffer)
+   )){
+      fprintf(stderr, "ERRO: %s n" "\xC3\xA3" "o " "\xC3\xA9" " um "
+         "estado salvo v" "\xC3\xA1" "lido.\n", nome_salvamento);
+      close(arquivo);
+      return EXIT_FAILURE;
+   }
+   if(
+      salvo.R != (uint64_t)R || salvo.por_decada != (uint64_t)por_decada ||
+      (por_decada == 0UL && salvo.intervalo != intervalo_escrita) ||
+      salvo.limiar != limiar
+   ){
+      fprintf(stderr, "ERRO: %s foi salvo com outras realiza"
+         "\xC3\xA7\xC3\xB5" "es, outros instantes de escrita ou "
+         "outro limiar.\n", nome_salvamento);
+      close(arquivo);
+      return EXIT_FAILURE;
+   }
+   tamanhos = malloc(R * sizeof(*tamanhos));
+   if(tamanhos == NULL || alocar_sistema((size_t)salvo.N,
+      nome_salvamento, SIZE_C(0)) != EXIT_SUCCESS){
+      free(tamanhos);
+      close(arquivo);
+      return EXIT_FAILURE;
+   }
+
+   /* as grandezas voltam com as suas bordas numa unica leitura */
+   iov[0].iov_base = E;
+   iov[0].iov_len = R * sizeof(*E);
+   iov[1].iov_base = tamanhos;
+   iov[1].iov_len = R * sizeof(*tamanhos);
+   iov[2].iov_base = buffer;
+   iov[2].iov_len = (4 * N * R + 3 * R) * sizeof(*buffer);
+   iov[3].iov_base = ativa;
+   iov[3].iov_len = R * sizeof(*ativa);
+   if(ler_tudo(arquivo, iov, 4) != 0){
+      fprintf(stderr, "ERRO: Falha ao ler %s.\n", nome_salvamento);
+   }else{
+      for(k = SIZE_C(0); k < N * R; ++k) inv_massa[k] = 1.0 / massa[k];
+      escrita = (unsigned long)salvo.escrita;
+      primeiro = (size_t)salvo.primeiro;
+      ultimo = (size_t)salvo.ultimo;
+      status = EXIT_SUCCESS;
+      for(r = SIZE_C(0); status == EXIT_SUCCESS && r < R; ++r){
+         status = abrir_saida(nome_arquivo[r], r);
+         if(saida[r] != NULL) retomar_arquivo(fileno(saida[r]), tamanhos[r]);
+      }
+      retomar_arquivo(binario, salvo.trajetoria);
+      if(deriva != NULL) retomar_arquivo(fileno(deriva), salvo.deriva);
+   }
+   free(tamanhos);
+   close(arquivo);
+   return status;
+}
+
+static int preparar_sistema(char **nome_arquivo, size_t realizacoes){
+   R = realizacoes;
+   E = calloc((2 + K) * R, sizeof(*E));
+   observados = E + 2 * R;
+   saida = calloc(R, sizeof(*saida));
+   ativa = calloc(R, sizeof(*ativa));
+   if(E == NULL || saida == NULL || ativa == NULL){
+      liberar_sistema();
+      return EXIT_FAILURE;
+   }
+
+   if(restaurar && ler_estado(nome_arquivo) != EXIT_SUCCESS){
+      liberar_sistema();
+      return EXIT_FAILURE;
+   }
+   for(size_t r = SIZE_C(0); !restaurar && r < R; ++r){
+      if(ler_realizacao(nome_arquivo[r], r) != EXIT_SUCCESS){
+         liberar_sistema();
+         return EXIT_FAILURE;
+      }
+   }
+   if(!restaurar){
+      primeiro = SIZE_C(0);
+      ultimo = N;
+   }
+
+   somas = malloc(6 * R * ((N + MEDIR_PEDACO - 1) / MEDIR_PEDACO)
+      * sizeof(*somas));
+   if(somas == NULL){
       fputs(
          "ERRO: "
          "N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente mem" "\xC3\xB3" "ria.\n",
          stderr
       );
-      fclose(arquivo);
-      return EXIT_FAILURE;
-   }
-   massa = buffer;
-   kappa = buffer + N + 1;
-   Q = buffer + 2*N + 2;
-   P = buffer + 3*N + 3;
-
-   /* por hipotese o arquivo deve conter N linhas com quatro colunas cada:
-      * a primeira coluna deve conter o valor da massa do corpo;
-      * a segunda deve conter o valor da constante de acoplamento harmonico
-        entre o corpo e o seguinte vizinho;
-      * a terceira o valor inicial do deslocamento do corpo;
-      * a quarta o valor inicial do momento linear do corpo. */
-   kappa[-1] = 0.0;
-   Q[-1] = Q[N] = 0.0;
-   for(size_t n = SIZE_C(0); n < N; ++n){
-      fscanf(
-         arquivo, "%lf %lf %lf %lf",
-         massa + n, kappa + n, Q + n, P + n
-      );
+      liberar_sistema();
+      return EXIT_FAILURE;
    }
-   fclose(arquivo);
 
-   /* calculo da energia inicial */
-   E = hamiltoniano();
+   /* calculo da energia inicial, a de um estado salvo eh a do inicio */
+   if(!restaurar) medir(E, NULL);
 
    return EXIT_SUCCESS;
 }
 
-static int escrever(double t){
-   if(fabs(E - hamiltoniano()) > 1.0e-8){
-      fprintf(stderr, "A energia n" "\xC3\xA3" "o foi conservada.\n");
+static void liberar_sistema(void){
+   if(saida != NULL){
+      for(size_t r = SIZE_C(0); r < R; ++r)
+         if(saida[r] != NULL && saida[r] != stdout) fclose(saida[r]);
+   }
+   free(saida);
+   free(ativa);
+   free(E);
+   free(somas);
+   free(buffer);
+   free(interpolados);
+   free(modos);
+   interpolados = NULL;
+   modos = frequencias = amplitudes = coeficientes = NULL;
+   if(espectro != NULL) fclose(espectro);
+   espectro = NULL;
+   somas = NULL;
+   saida = NULL;
+   ativa = NULL;
+   E = NULL;
+   buffer = NULL;
+   if(binario >= 0) close(binario);
+   binario = -1;
+   if(deriva != NULL) fclose(deriva);
+   deriva = NULL;
+}
+
+/* Escreve todos os bytes apontados por `iov`, mesmo que `writev`
+   aceite apenas uma parte deles por chamada. */
+static int escrever_tudo(int fd, struct iovec *iov, int quantos){
+   ssize_t escritos;
+
+   while(quantos > 0){
+      escritos = writev(fd, iov, quantos);
+      if(escritos < 0) return 1;
+      for(; quantos > 0 && (size_t)escritos >= iov->iov_len; ++iov, --quantos)
+         escritos -= (ssize_t)iov->iov_len;
+      if(quantos > 0){
+         iov->iov_base = (char*)iov->iov_base + escritos;
+         iov->iov_len -= (size_t)escritos;
+      }
+   }
+   return 0;
+}
+
+static int escrever_trajetoria(struct iovec *iov, int quantos){
+   if(escrever_tudo(binario, iov, quantos) == 0) return 0;
+   fputs("ERRO: Falha ao escrever a trajet" "\xC3\xB3" "ria.\n", stderr);
+   return 1;
+}
+
+/* Cabecalho da trajetoria binaria, ou, com a opcao -o, a linha de
+   comentario que da o nome de cada coluna. */
+static int escrever_cabecalho(double h, double intervalo){
+   cabecalho_trajetoria cabecalho;
+   struct iovec iov;
+   size_t r, k;
+
+   if(binario < 0){
+      for(r = SIZE_C(0); K > SIZE_C(0) && r < R; ++r){
+         fprintf(saida[r], "# t");
+         for(k = SIZE_C(0); k < K; ++k)
+            fprintf(saida[r], " %s", nomes_observaveis[observaveis[k]]);
+         fprintf(saida[r], "\n");
+      }
+      return 0;
+   }
+   memset(&cabecalho, 0, sizeof(cabecalho));
+   memcpy(cabecalho.magica, TRAJETORIA_MAGICA, sizeof(TRAJETORIA_MAGICA));
+   cabecalho.versao = TRAJETORIA_VERSAO;
+   cabecalho.tipo = TRAJETORIA_DOUBLE;
+   cabecalho.N = N;
+   cabecalho.R = R;
+   cabecalho.h = h;
+   cabecalho.intervalo = intervalo;
+   iov.iov_base = &cabecalho;
+   iov.iov_len = sizeof(cabecalho);
+   return escrever_trajetoria(&iov, 1);
+}
+
+/* No formato binario o quadro eh escrito direto da copia de Q e P,
+   sem formatacao e com todos os algarismos. */
+static int escrever_quadro(quadro *q){
+   struct iovec iov[3];
+   size_t r, n;
+
+   if(binario >= 0){
+      iov[0].iov_base = &q->t;
+      iov[0].iov_len = sizeof(q->t);
+      iov[1].iov_base = q->Q;
+      iov[1].iov_len = N * R * sizeof(*q->Q);
+      iov[2].iov_base = q->P;
+      iov[2].iov_len = N * R * sizeof(*q->P);
+      PERFIL_BYTES(iov[0].iov_len + iov[1].iov_len + iov[2].iov_len);
+      return escrever_trajetoria(iov, 3);
+   }
+
+   for(r = SIZE_C(0); K > SIZE_C(0) && r < R; ++r){
+      if(!q->ativa[r]) continue;
+      PERFIL_BYTES(fprintf(saida[r], "%g", q->t));
+      for(n = SIZE_C(0); n < K; ++n)
+         PERFIL_BYTES(fprintf(saida[r], " %.12g", q->O[r*K + n]));
+      PERFIL_BYTES(fprintf(saida[r], "\n"));
+   }
+   for(r = SIZE_C(0); K == SIZE_C(0) && r < R; ++r){
+      if(!q->ativa[r]) continue;
+      for(n = SIZE_C(0); n < N; ++n){
+         PERFIL_BYTES(fprintf(saida[r], "%g %u %g %g\n",
+            q->t, (unsigned)n, q->Q[n*R + r], q->P[n*R + r]));
+      }
+      PERFIL_BYTES(fprintf(saida[r], "\n"));
+   }
+   return 0;
+}
+
+static void *escrever_quadros(void *argumento){
+   int atual = 0, erro;
+   (void)argumento;
+
+   for(;;){
+      pthread_mutex_lock(&escritor.trava);
+      while(!escritor.cheio[atual] && !escritor.fim)
+         pthread_cond_wait(&escritor.sinal, &escritor.trava);
+      if(!escritor.cheio[atual]){
+         pthread_mutex_unlock(&escritor.trava);
+         break;
+      }
+      pthread_mutex_unlock(&escritor.trava);
+
+      PERFIL_ESCRITA_INICIO();
+      erro = escrever_quadro(escritor.quadros + atual);
+
+      pthread_mutex_lock(&escritor.trava);
+      PERFIL_ESCRITA_FIM();
+      escritor.cheio[atual] = 0;
+      if(erro) escritor.erro = 1;
+      pthread_cond_broadcast(&escritor.sinal);
+      pthread_mutex_unlock(&escritor.trava);
+      atual ^= 1;
+   }
+   return NULL;
+}
+
+static int iniciar_escritor(void){
+   double *memoria;
+   size_t tamanho = (K > SIZE_C(0) ? K * R : 2 * N * R) + R;
+
+   /* os dois quadros ficam em um unico bloco, liberado por
+      `terminar_escritor` */
+   memoria = malloc(2 * tamanho * sizeof(*memoria));
+   if(memoria == NULL){
+      fputs(
+         "ERRO: "
+         "N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente mem" "\xC3\xB3" "ria.\n",
+         stderr
+      );
       return 1;
    }
-   for(size_t n = SIZE_C(0); n < N; ++n){
-      fprintf(stdout, "%g %u %g %g\n", t, (unsigned)n, Q[n], P[n]);\
+   for(int k = 0; k < 2; ++k){
+      escritor.quadros[k].Q = memoria + k * tamanho;
+      escritor.quadros[k].O = escritor.quadros[k].Q;
+      escritor.quadros[k].P = escritor.quadros[k].Q + N * R;
+      escritor.quadros[k].ativa = (unsigned char*)(
+         K > SIZE_C(0) ? escritor.quadros[k].O + K * R :
+         escritor.quadros[k].P + N * R);
+   }
+   if(pthread_create(&escritor.fio, NULL, escrever_quadros, NULL) != 0){
+      fputs("ERRO: N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+         "iniciar o escritor.\n", stderr);
+      free(memoria);
+      escritor.quadros[0].Q = NULL;
+      return 1;
    }
-   fprintf(stdout, "\n");
    return 0;
 }
 
-static double dot_Q(size_t n, double *P){
-   return P[n] / massa[n];
+/* Espera o escritor esvaziar os quadros pendentes. */
+static int terminar_escritor(void){
+   PERFIL_ENTRAR(FASE_ESPERA);
+   pthread_mutex_lock(&escritor.trava);
+   escritor.fim = 1;
+   pthread_cond_broadcast(&escritor.sinal);
+   pthread_mutex_unlock(&escritor.trava);
+   pthread_join(escritor.fio, NULL);
+   PERFIL_SAIR();
+   free(escritor.quadros[0].Q);
+   escritor.quadros[0].Q = NULL;
+
+   if(escritor.descartados > 0UL){
+      fprintf(stderr, "AVISO: %lu quadros foram descartados.\n",
+         escritor.descartados);
+   }
+   return escritor.erro ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* Espera o escritor esvaziar os quadros entregues, sem termina-lo. */
+static int esperar_escritor(void){
+   int erro;
+
+   pthread_mutex_lock(&escritor.trava);
+   while((escritor.cheio[0] || escritor.cheio[1]) && !escritor.erro)
+      pthread_cond_wait(&escritor.sinal, &escritor.trava);
+   erro = escritor.erro;
+   pthread_mutex_unlock(&escritor.trava);
+   return erro;
+}
+
+/* Garante que o que foi escrito num arquivo de saida esta no disco e
+   retorna o seu tamanho, ou SALVAMENTO_SEM_TAMANHO se ele nao tem um. */
+static uint64_t fixar_arquivo(int fd){
+   off_t tamanho;
+
+   if(fd < 0) return SALVAMENTO_SEM_TAMANHO;
+   tamanho = lseek(fd, 0, SEEK_CUR);
+   if(tamanho < 0) return SALVAMENTO_SEM_TAMANHO;
+   fsync(fd);
+   return (uint64_t)tamanho;
+}
+
+/* O estado eh escrito em `arquivo.tmp` e so entao renomeado, de modo que o
+   arquivo da opcao -c tem sempre um estado completo. As grandezas saem
+   direto da memoria, com as bordas, numa unica escrita sequencial. Antes
+   o escritor eh esvaziado e as saidas vao para o disco, para que os seus
+   tamanhos correspondam ao estado salvo. */
+static int salvar_estado(const pvi_contextus *contexto){
+   cabecalho_salvamento cabecalho;
+   struct iovec iov[5];
+   uint64_t *tamanhos;
+   char *temporario;
+   size_t r;
+   int arquivo = -1, status = 1;
+
+   tamanhos = malloc(R * sizeof(*tamanhos));
+   temporario = malloc(strlen(nome_salvamento) + sizeof(".tmp"));
+   if(tamanhos == NULL || temporario == NULL){
+      fputs(
+         "ERRO: "
+         "N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente mem" "\xC3\xB3" "ria.\n",
+         stderr
+      );
+      free(tamanhos);
+      free(temporario);
+      return 1;
+   }
+   if(esperar_escritor() != 0) goto fim;
+
+   memset(&cabecalho, 0, sizeof(cabecalho));
+   memcpy(cabecalho.magica, SALVAMENTO_MAGICA, sizeof(SALVAMENTO_MAGICA));
+   cabecalho.versao = SALVAMENTO_VERSAO;
+   cabecalho.tipo = (uint32_t)sizeof(real);
+   cabecalho.mantissa = REAL_MANTISSA;
+   cabecalho.N = N;
+   cabecalho.R = R;
+   cabecalho.esquema = (uint32_t)contexto->methodus;
+   cabecalho.passo = passo;
+   cabecalho.escrita = escrita;
+   cabecalho.por_decada = por_decada;
+   cabecalho.h = contexto->h;
+   cabecalho.t = contexto->tempus;
+   cabecalho.intervalo = intervalo_escrita;
+   cabecalho.limiar = limiar;
+   cabecalho.primeiro = primeiro;
+   cabecalho.ultimo = ultimo;
+   cabecalho.trajetoria = fixar_arquivo(binario);
+   cabecalho.deriva = SALVAMENTO_SEM_TAMANHO;
+   if(deriva != NULL && fflush(deriva) == 0)
+      cabecalho.deriva = fixar_arquivo(fileno(deriva));
+   for(r = SIZE_C(0); r < R; ++r){
+      tamanhos[r] = SALVAMENTO_SEM_TAMANHO;
+      if(saida[r] != NULL && fflush(saida[r]) == 0)
+         tamanhos[r] = fixar_arquivo(fileno(saida[r]));
+   }
+
+   iov[0].iov_base = &cabecalho;
+   iov[0].iov_len = sizeof(cabecalho);
+   iov[1].iov_base = E;
+   iov[1].iov_len = R * sizeof(*E);
+   iov[2].iov_base = tamanhos;
+   iov[2].iov_len = R * sizeof(*tamanhos);
+   iov[3].iov_base = buffer;
+   iov[3].iov_len = (4 * N * R + 3 * R) * sizeof(*buffer);
+   iov[4].iov_base = ativa;
+   iov[4].iov_len = R * sizeof(*ativa);
+
+   strcpy(temporario, nome_salvamento);
+   strcat(temporario, ".tmp");
+   arquivo = open(temporario, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+   if(arquivo < 0) goto fim;
+   status = (escrever_tudo(arquivo, iov, 5) != 0 || fsync(arquivo) != 0);
+   if(close(arquivo) != 0) status = 1;
+   if(status == 0 && rename(temporario, nome_salvamento) != 0) status = 1;
+   if(status != 0) unlink(temporario);
+
+fim:
+   if(status != 0){
+      fprintf(stderr, "ERRO: N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+         "salvar o estado em %s.\n", nome_salvamento);
+   }
+   free(tamanhos);
+   free(temporario);
+   return status;
+}
+
+/* Entrega o estado atual ao escritor. */
+static int entregar_quadro(double t){
+   quadro *q;
+   size_t n;
+   int k;
+
+   PERFIL_ENTRAR(FASE_ESPERA);
+   pthread_mutex_lock(&escritor.trava);
+   k = escritor.proximo;
+   if(escritor.cheio[k] && escritor.descartar && !escritor.erro){
+      ++escritor.descartados;
+      pthread_mutex_unlock(&escritor.trava);
+      PERFIL_SAIR();
+      fprintf(stderr, "AVISO: O escritor est" "\xC3\xA1" " atrasado, "
+         "o quadro de t = %g foi descartado.\n", t);
+      return 0;
+   }
+   while(escritor.cheio[k] && !escritor.erro)
+      pthread_cond_wait(&escritor.sinal, &escritor.trava);
+   pthread_mutex_unlock(&escritor.trava);
+   PERFIL_SAIR();
+   if(escritor.erro) return 1;
+
+   PERFIL_ENTRAR(FASE_ENTREGA);
+   /* o escritor nao toca num quadro vazio, a copia dispensa a trava; os
+      quadros sao sempre em double, qualquer que seja a precisao */
+   q = escritor.quadros + k;
+   q->t = t;
+   if(K > SIZE_C(0)){
+      for(n = SIZE_C(0); n < K * R; ++n) q->O[n] = (double)observados[n];
+   }else{
+      for(n = SIZE_C(0); n < N * R; ++n){
+         q->Q[n] = (double)Q[n];
+         q->P[n] = (double)P[n];
+      }
+   }
+   memcpy(q->ativa, ativa, R * sizeof(*ativa));
+
+   pthread_mutex_lock(&escritor.trava);
+   escritor.cheio[k] = 1;
+   escritor.proximo = k ^ 1;
+   pthread_cond_broadcast(&escritor.sinal);
+   pthread_mutex_unlock(&escritor.trava);
+   PERFIL_SAIR();
+   PERFIL_QUADRO();
+   return 0;
+}
+
+/* Cada realizacao tem o seu teste de conservacao da energia, a que falha
+   deixa de ser escrita (no formato binario ela segue no quadro, mas eh
+   avisada) e a integracao para quando todas falharem. */
+static int conferir_energia(double t){
+   const acumulador *H = E + R;
+   size_t r, ativas = SIZE_C(0);
+   double desvio;
+
+   PERFIL_SOMAR(conferencias, 1UL);
+   if(deriva != NULL) fprintf(deriva, "%.10g", t);
+   for(r = SIZE_C(0); r < R; ++r){
+      desvio = H[r] - E[r];
+      if(E[r] != 0.0) desvio /= fabs((double)E[r]);
+      if(deriva != NULL) fprintf(deriva, " %.6e", desvio);
+      if(!ativa[r]) continue;
+      if(tolerancia > 0.0 && !(fabs(desvio) <= tolerancia)){
+         if(R == SIZE_C(1))
+            fprintf(stderr, "A energia n" "\xC3\xA3" "o foi conservada "
+               "(desvio relativo %g em t = %g).\n", desvio, t);
+         else
+            fprintf(stderr, "A energia n" "\xC3\xA3" "o foi conservada "
+               "na realiza" "\xC3\xA7\xC3\xA3" "o %zu (desvio relativo "
+               "%g em t = %g).\n", r, desvio, t);
+         ativa[r] = 0;
+         continue;
+      }
+      ++ativas;
+   }
+   if(deriva != NULL) fprintf(deriva, "\n");
+   return (ativas == SIZE_C(0));
+}
+
+/* Conferencia da energia fora dos instantes de escrita. */
+static int monitorar(double t){
+   medir(E + R, NULL);
+   return conferir_energia(t);
+}
+
+/* Nos instantes de escrita a energia e os observaveis saem da mesma
+   passagem pela rede. */
+static int escrever(double t, int conferir){
+   if(conferir || K > SIZE_C(0))
+      medir(E + R, K > SIZE_C(0) ? observados : NULL);
+   if(conferir && conferir_energia(t) != 0) return 1;
+
+   return entregar_quadro(t);
+}
+
+/* A interacao eh apenas entre primeiros vizinhos, entao todos os
+   subpassos do esquema podem ser feitos em uma unica varredura, e como
+   `dot_Q` eh linear em P os esquemas RKN mantem a sua ordem. O contexto
+   cobre apenas a janela ativa, com os vetores e os parametros deslocados
+   para o seu primeiro corpo. */
+static pvi_contextus *criar_contexto(int esquema, double h, double t){
+   const size_t inicio = primeiro * R;
+   pvi_contextus *contexto;
+
+   contexto = pvi_crea(esquema, (ultimo - primeiro) * R, h);
+   if(contexto == NULL) return NULL;
+   parametros.R = R;
+   parametros.kappa = kappa + inicio;
+   parametros.inv_massa = inv_massa + inicio;
+   contexto->fusus = 1;
+   contexto->tempus = t;
+   contexto->densus = (instante(escrita) <= t + h);
+   contexto->x = Q + inicio;
+   contexto->y = P + inicio;
+   contexto->gradus_X = arrastar;
+   contexto->gradus_Y = chutar;
+   contexto->data = &parametros;
+   /* o estencil de `dot_P` alcanca R posicoes de cada lado */
+   contexto->blocus = (R > SIZE_C(64) ? R : SIZE_C(64));
+   return contexto;
+}
+
+/* `pvi_curre_gradus` embute o laco do integrador em cada versao abaixo,
+   compilada com o conjunto de instrucoes do seu nucleo: o nucleo eh
+   chamado direto, e embutido, na varredura em onda, em vez de uma chamada
+   indireta a cada bloco de `blocus` corpos. Cada versao fica fora de
+   `main`, onde a escalar embutida perdia o `dot_P` embutido. */
+#define CURRE(sufixo) \
+__attribute__((noinline)) static int curre_##sufixo(pvi_contextus *contexto){\
+   return pvi_curre_gradus(contexto, tempo_final, a_cada_passo,\
+      arrastar_##sufixo, chutar_##sufixo);\
+}
+CURRE(escalar)
+#if defined(NUCLEOS_VETORIAIS)
+__attribute__((target("sse2"), optimize("fp-contract=off"))) CURRE(sse2)
+__attribute__((target("avx2"), optimize("fp-contract=off"))) CURRE(avx2)
+__attribute__((target("avx512f"), optimize("fp-contract=off"))) CURRE(avx512)
+#endif
+
+static int curre(pvi_contextus *contexto){
+   switch(nivel_nucleos){
+#if defined(NUCLEOS_VETORIAIS)
+      case 3: return curre_avx512(contexto);
+      case 2: return curre_avx2(contexto);
+      case 1: return curre_sse2(contexto);
+#endif
+      default: return curre_escalar(contexto);
+   }
+}
+
+/* A janela inicial vai de JANELA_MARGEM corpos antes do primeiro corpo
+   fora do repouso, em qualquer realizacao, ate JANELA_MARGEM depois do
+   ultimo. */
+static void iniciar_janela(void){
+   size_t k, menor = N * R, maior = SIZE_C(0);
+
+   for(k = SIZE_C(0); k < N * R; ++k){
+      if(Q[k] == 0.0 && P[k] == 0.0) continue;
+      if(k < menor) menor = k;
+      maior = k;
+   }
+   /* a rede parada fica parada, basta uma janela no meio */
+   if(menor > maior) menor = maior = N / 2 * R;
+   menor /= R;
+   maior = maior / R + 1;
+   primeiro = (menor > JANELA_MARGEM ? menor - JANELA_MARGEM : SIZE_C(0));
+   ultimo = (N - maior > JANELA_MARGEM ? maior + JANELA_MARGEM : N);
+}
+
+static int fora_do_repouso(size_t inicio, size_t fim){
+   for(size_t k = inicio * R; k < fim * R; ++k)
+      if(fabs((double)Q[k]) > limiar || fabs((double)P[k]) > limiar)
+         return 1;
+   return 0;
 }
-static double dot_P(size_t n, double *Q){
-   return kappa[n] * (Q[n+1] - Q[n]) - kappa[n-1] * (Q[n] - Q[n-1]);
+
+/* Retorna 1 se a janela cresceu. */
+static int alargar_janela(void){
+   const size_t largura = ultimo - primeiro;
+   const size_t margem = (largura < JANELA_MARGEM ? largura : JANELA_MARGEM);
+   int esquerda, direita;
+
+   esquerda = (primeiro > SIZE_C(0) &&
+      fora_do_repouso(primeiro, primeiro + margem));
+   direita = (ultimo < N && fora_do_repouso(ultimo - margem, ultimo));
+   if(esquerda)
+      primeiro = (primeiro > largura ? primeiro - largura : SIZE_C(0));
+   if(direita)
+      ultimo = (N - ultimo > largura ? ultimo + largura : N);
+   return (esquerda || direita);
 }
 
-static double square(double x){
+static acumulador square(acumulador x){
    return x*x;
 }
-static double hamiltoniano(void){
-   double H = 0.0;
-   for(size_t n = SIZE_C(0); n < N; ++n){
-      // energia cinetica
-      H += 0.5 * square(P[n]) / massa[n];
-      // energia potencial
-      H += 0.25 * kappa[n] * square(Q[n+1] - Q[n]);
-      H += 0.25 * kappa[n-1] * square(Q[n] - Q[n-1]);
+/* A energia e os observaveis sao calculados numa unica passagem pela
+   rede, dividida em pedacos fixos de MEDIR_PEDACO corpos. Cada ligacao
+   entra uma unica vez, com kappa_n (Q_n+1 - Q_n)^2 / 2 (a do ultimo corpo
+   eh a mola presa a parede), e a energia de cada pedaco eh acumulada com
+   a soma compensada de Kahan. As somas parciais dos pedacos sao somadas
+   depois, sempre na mesma ordem, de modo que o resultado nao depende do
+   numero de fios de execucao. A posicao eh medida a partir do meio da
+   cadeia, onde costuma estar a excitacao, para que o segundo momento nao
+   perca algarismos. */
+#define KAHAN(soma, compensacao, x) {\
+   const acumulador kahan_y = (x) - (compensacao);\
+   const acumulador kahan_t = (soma) + kahan_y;\
+   (compensacao) = (kahan_t - (soma)) - kahan_y;\
+   (soma) = kahan_t;\
+}
+static acumulador ligacao(size_t k){
+   return 0.5 * kappa[k] * square((acumulador)Q[k+R] - Q[k]);
+}
+static acumulador energia_do_corpo(size_t n, size_t r){
+   const size_t k = n * R + r;
+   return 0.5 * square(P[k]) * inv_massa[k]
+      + 0.5 * ligacao(k - R) + (n + 1 < N ? 0.5 : 1.0) * ligacao(k);
+}
+static void medir(acumulador *H, acumulador *O){
+   /* fora da janela ativa a rede esta parada, so contam os pedacos com
+      algum corpo dela ou com a ligacao que chega ao seu primeiro corpo */
+   const size_t pedacos = (ultimo + MEDIR_PEDACO - 1) / MEDIR_PEDACO;
+   const size_t pedaco0 =
+      (primeiro > SIZE_C(0) ? primeiro - 1 : SIZE_C(0)) / MEDIR_PEDACO;
+   const double meio = 0.5 * (double)(N - 1);
+   acumulador *total = somas + 6 * R * pedaco0;
+   size_t j, r, k;
+
+   PERFIL_ENTRAR(FASE_MEDIDA);
+   /* em cada pedaco: energia, compensacao, sum x e_n, sum x^2 e_n,
+      sum e_n^2 e a ultima ligacao vista */
+   PARALELO
+   for(j = pedaco0; j < pedacos; ++j){
+      acumulador *s = somas + 6 * R * j, b, c, e, x;
+      size_t n, i, inicio = j * MEDIR_PEDACO, fim = inicio + MEDIR_PEDACO;
+      if(fim > N) fim = N;
+      for(i = SIZE_C(0); i < R; ++i){
+         s[i] = s[R + i] = s[2*R + i] = s[3*R + i] = s[4*R + i] = 0.0;
+         s[5*R + i] = ligacao(inicio * R + i - R);
+      }
+      for(n = inicio; n < fim; ++n){
+         x = (acumulador)n - meio;
+         for(i = SIZE_C(0); i < R; ++i){
+            c = 0.5 * square(P[n*R + i]) * inv_massa[n*R + i];
+            b = ligacao(n*R + i);
+            KAHAN(s[i], s[R + i], c + b);
+            if(O == NULL) continue;
+            e = c + 0.5 * s[5*R + i] + (n + 1 < N ? 0.5 : 1.0) * b;
+            s[5*R + i] = b;
+            s[2*R + i] += x * e;
+            s[3*R + i] += x * x * e;
+            s[4*R + i] += e * e;
+         }
+      }
+   }
+   for(r = SIZE_C(0); r < 5 * R; ++r){
+      if(r >= R && r < 2 * R) continue;
+      for(j = pedaco0 + 1; j < pedacos; ++j){
+         if(r < R){
+            KAHAN(total[r], total[R + r], somas[6 * R * j + r]);
+            KAHAN(total[r], total[R + r], -somas[6 * R * j + R + r]);
+         }else{
+            total[r] += somas[6 * R * j + r];
+         }
+      }
+   }
+   for(r = SIZE_C(0); r < R; ++r) H[r] = total[r] - total[R + r];
+
+   for(r = SIZE_C(0); O != NULL && r < R; ++r){
+      const acumulador soma = H[r], centro = total[2*R + r] / soma;
+      for(k = SIZE_C(0); k < K; ++k){
+         acumulador *o = O + r * K + k;
+         switch(observaveis[k]){
+            case ENERGIA: *o = soma; break;
+            case CENTRO: *o = meio + centro; break;
+            case ESPALHAMENTO:
+               *o = total[3*R + r] / soma - centro * centro;
+               break;
+            case PARTICIPACAO: *o = soma * soma / total[4*R + r]; break;
+            case ESQUERDA: *o = energia_do_corpo(SIZE_C(0), r); break;
+            case DIREITA: *o = energia_do_corpo(N - 1, r); break;
+         }
+      }
    }
-   return H;
+   PERFIL_SAIR();
 }
 
-static size_t contar_linhas(FILE *arquivo){
-   int byte;
-   long int offset;
-   size_t linhas = SIZE_C(1);
+/* Na coordenada u_n = sqrt(m_n) Q_n a matriz dinamica eh tridiagonal,
+   com diagonal (kappa_n-1 + kappa_n) / m_n e vizinhos
+   -kappa_n / sqrt(m_n m_n+1), e cada modo k de frequencia omega_k evolui
+   como a_k cos(omega_k t) + b_k sin(omega_k t) / omega_k, com a_k e b_k
+   as projecoes de u e de du/dt = P_n / sqrt(m_n) iniciais. */
+static int diagonalizar(void){
+   double_p d, e, Z, u, w;
+   double m, maior, quarta;
+   size_t r, n, k;
+
+   if(R * N > SIZE_MAX / sizeof(*modos) / N){
+      fputs(
+         "ERRO: "
+         "N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente mem" "\xC3\xB3" "ria.\n",
+         stderr
+      );
+      return 1;
+   }
+   modos = malloc((R * N * N + 3 * N * R + 2 * N) * sizeof(*modos));
+   if(modos == NULL){
+      fputs(
+         "ERRO: "
+         "N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente mem" "\xC3\xB3" "ria.\n",
+         stderr
+      );
+      return 1;
+   }
+   frequencias = modos + R * N * N;
+   amplitudes = frequencias + N * R;
+   coeficientes = amplitudes + 2 * N * R;
+   if(espectro != NULL) fprintf(espectro, "# r k omega participacao\n");
+
+   for(r = SIZE_C(0); r < R; ++r){
+      d = frequencias + r * N;
+      e = coeficientes;
+      Z = modos + r * N * N;
+      for(n = SIZE_C(0); n < N; ++n){
+         d[n] = (kappa[n*R + r - R] + kappa[n*R + r]) * inv_massa[n*R + r];
+         if(n + 1 < N){
+            e[n] = -kappa[n*R + r] /
+               sqrt(massa[n*R + r] * massa[(n + 1)*R + r]);
+         }
+      }
+      if(diagonalizar_tridiagonal(N, d, e, Z) != 0){
+         fprintf(stderr, "ERRO: A diagonaliza" "\xC3\xA7\xC3\xA3" "o da "
+            "realiza" "\xC3\xA7\xC3\xA3" "o %zu n" "\xC3\xA3" "o "
+            "convergiu.\n", r);
+         return 1;
+      }
+      /* autovalores negativos so sao tolerados como arredondamento de
+         um modo de frequencia nula */
+      maior = (N > SIZE_C(0) ? fabs(d[N - 1]) : 0.0);
+      if(N > SIZE_C(0) && d[0] < -1e-12 * maior){
+         fprintf(stderr, "ERRO: A realiza" "\xC3\xA7\xC3\xA3" "o %zu "
+            "n" "\xC3\xA3" "o " "\xC3\xA9" " est" "\xC3\xA1" "vel "
+            "(autovalor %g).\n", r, d[0]);
+         return 1;
+      }
+      u = amplitudes + 2 * r * N;
+      w = u + N;
+      for(k = SIZE_C(0); k < N; ++k){
+         d[k] = (d[k] > 0.0 ? sqrt(d[k]) : 0.0);
+         u[k] = w[k] = quarta = 0.0;
+         for(n = SIZE_C(0); n < N; ++n){
+            m = massa[n*R + r];
+            u[k] += Z[k * N + n] * sqrt(m) * Q[n*R + r];
+            w[k] += Z[k * N + n] * P[n*R + r] / sqrt(m);
+            quarta += square(square(Z[k * N + n]));
+         }
+         if(espectro != NULL)
+            fprintf(espectro, "%zu %zu %.17g %.17g\n", r, k, d[k],
+               1.0 / quarta);
+      }
+   }
+   if(espectro != NULL && (ferror(espectro) || fclose(espectro) != 0)){
+      espectro = NULL;
+      fputs("ERRO: Falha ao escrever o espectro dos modos.\n", stderr);
+      return 1;
+   }
+   espectro = NULL;
+   return 0;
+}
 
-   offset = ftell(arquivo);
-   fseek(arquivo, 0L, SEEK_SET);
+/* Q e P no instante t, a partir das amplitudes dos modos. */
+static void compor_modos(double t){
+   const size_t pedacos = (N + MEDIR_PEDACO - 1) / MEDIR_PEDACO;
+   size_t r, k, j;
 
-   loop: {
-      byte = fgetc(arquivo);
-      if(byte != EOF){
-         if(byte == (int)'\n') ++linhas;
-         goto loop;
+   PERFIL_ENTRAR(FASE_MODOS);
+   for(r = SIZE_C(0); r < R; ++r){
+      const double *omega = frequencias + r * N, *a = amplitudes + 2 * r * N,
+         *b = a + N, *Z = modos + r * N * N;
+      double *cq = coeficientes, *cp = coeficientes + N, c, s;
+      for(k = SIZE_C(0); k < N; ++k){
+         c = cos(omega[k] * t);
+         s = sin(omega[k] * t);
+         cq[k] = a[k] * c + b[k] * (omega[k] > 0.0 ? s / omega[k] : t);
+         cp[k] = b[k] * c - a[k] * omega[k] * s;
+      }
+      /* cada pedaco percorre as linhas de Z, contiguas, e acumula em Q e
+         P, que cabem na cache */
+      PARALELO
+      for(j = SIZE_C(0); j < pedacos; ++j){
+         size_t n, i, inicio = j * MEDIR_PEDACO, fim = inicio + MEDIR_PEDACO;
+         const double *z;
+         double raiz;
+         if(fim > N) fim = N;
+         for(n = inicio; n < fim; ++n) Q[n*R + r] = P[n*R + r] = 0.0;
+         for(i = SIZE_C(0); i < N; ++i){
+            z = Z + i * N;
+            for(n = inicio; n < fim; ++n){
+               Q[n*R + r] += cq[i] * z[n];
+               P[n*R + r] += cp[i] * z[n];
+            }
+         }
+         for(n = inicio; n < fim; ++n){
+            raiz = sqrt(massa[n*R + r]);
+            Q[n*R + r] /= raiz;
+            P[n*R + r] *= raiz;
+         }
       }
    }
+   PERFIL_SAIR();
+}
 
-   fseek(arquivo, offset, SEEK_SET);
+/* Escreve os instantes pedidos ate o tempo final, a energia eh conferida
+   em todos eles e so denuncia o arredondamento da diagonalizacao. */
+static void curre_modos(void){
+   double t;
+
+   for(; (t = instante(escrita)) <= tempo_final; ++escrita){
+      compor_modos(t);
+      if(escrever(t, 1) != 0) break;
+   }
+}
+
+/* Interpreta a lista da opcao -o, `bordas` equivale a `esquerda,direita`.
+   Retorna diferente de 0 se algum nome for desconhecido. */
+static int escolher_observaveis(char *lista){
+   size_t tamanho;
+   int o;
+
+   while(*lista != '\0'){
+      tamanho = strcspn(lista, ",");
+      for(o = 0; o < OBSERVAVEIS; ++o){
+         if(
+            strlen(nomes_observaveis[o]) == tamanho &&
+            strncmp(lista, nomes_observaveis[o], tamanho) == 0
+         ) break;
+      }
+      if(o == OBSERVAVEIS && tamanho == 6 && strncmp(lista, "bordas", 6) == 0){
+         if(K + 2 > SIZE_C(2 * OBSERVAVEIS)) return 1;
+         observaveis[K++] = ESQUERDA;
+         observaveis[K++] = DIREITA;
+      }else if(o < OBSERVAVEIS && K < SIZE_C(2 * OBSERVAVEIS)){
+         observaveis[K++] = o;
+      }else{
+         fprintf(stderr, "ERRO: Observ" "\xC3\xA1" "vel desconhecido: "
+            "%.*s.\n", (int)tamanho, lista);
+         return 1;
+      }
+      lista += tamanho;
+      if(*lista == ',') ++lista;
+   }
+   return 0;
+}
+
+/* Conta as linhas de um trecho de texto, a ultima pode nao terminar em
+   '\n'. A busca por '\n' eh feita por `memchr`, que a biblioteca C
+   implementa com instrucoes vetoriais. */
+static size_t contar_linhas(const char *texto, size_t tamanho){
+   const char *p = texto, *fim = texto + tamanho;
+   size_t linhas = SIZE_C(0);
+
+   while(p < fim && (p = memchr(p, '\n', (size_t)(fim - p))) != NULL){
+      ++linhas;
+      ++p;
+   }
+   if(tamanho > SIZE_C(0) && texto[tamanho - 1] != '\n') ++linhas;
 
    return linhas;
 }
+
+#ifdef CLASSICO_PERFIL
+static double perfil_agora(void){
+   struct timespec agora;
+   clock_gettime(CLOCK_MONOTONIC, &agora);
+   return (double)agora.tv_sec + 1e-9 * (double)agora.tv_nsec;
+}
+
+/* Abre o contador 0 (ciclos) ou 1 (faltas na ultima cache) do fio
+   principal, -1 se o nucleo ou as permissoes nao deixarem. */
+static int perfil_contador(int k){
+#if defined(__linux__)
+   struct perf_event_attr atributos;
+
+   memset(&atributos, 0, sizeof(atributos));
+   atributos.type = PERF_TYPE_HARDWARE;
+   atributos.size = sizeof(atributos);
+   atributos.config = (k == 0 ?
+      PERF_COUNT_HW_CPU_CYCLES : PERF_COUNT_HW_CACHE_MISSES);
+   atributos.exclude_kernel = 1;
+   atributos.exclude_hv = 1;
+   return (int)syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0UL);
+#else
+   (void)k;
+   return -1;
+#endif
+}
+
+/* Credita a fase do topo da pilha com o tempo e os eventos desde a
+   ultima marca. */
+static void perfil_marcar(void){
+   const int fase = perfil.pilha[perfil.topo];
+   const double agora = perfil_agora();
+   uint64_t valor;
+   int k;
+
+   perfil.tempo[fase] += agora - perfil.marca;
+   perfil.marca = agora;
+   for(k = 0; k < 2; ++k){
+      if(perfil.descritores[k] < 0) continue;
+      if(read(perfil.descritores[k], &valor, sizeof(valor)) !=
+         (ssize_t)sizeof(valor)) continue;
+      perfil.eventos[k][fase] += valor - perfil.contadores[k];
+      perfil.contadores[k] = valor;
+   }
+}
+
+static void perfil_entrar(int fase){
+   perfil_marcar();
+   if(perfil.topo + 1 < (int)(sizeof(perfil.pilha) / sizeof(*perfil.pilha)))
+      perfil.pilha[++perfil.topo] = fase;
+}
+
+static void perfil_sair(void){
+   perfil_marcar();
+   if(perfil.topo > 0) --perfil.topo;
+}
+
+/* Escreve o relatorio na saida de erro, uma tabela ou uma linha JSON. */
+static void perfil_relatar(void){
+   const double total = perfil_agora() - perfil.inicio;
+   const unsigned long avaliacoes =
+      perfil.avaliacoes + perfil.avaliacoes_atuais;
+   double tempo[FASES];
+   unsigned long descartados;
+   uint64_t bytes;
+   int f, k;
+
+   perfil_marcar();
+   memcpy(tempo, perfil.tempo, sizeof(tempo));
+   pthread_mutex_lock(&escritor.trava);
+   tempo[FASE_ESCRITA] = perfil.tempo[FASE_ESCRITA];
+   bytes = perfil.bytes;
+   descartados = escritor.descartados;
+   pthread_mutex_unlock(&escritor.trava);
+
+   if(perfil.json){
+      fprintf(stderr, "{\"segundos\": %.6f, \"fases\": {", total);
+      for(f = 0; f < FASES; ++f){
+         fprintf(stderr, "%s\"%s\": {\"segundos\": %.6f",
+            f > 0 ? ", " : "", nomes_fases[f], tempo[f]);
+         for(k = 0; k < 2; ++k){
+            fprintf(stderr, ", \"%s\": ", k == 0 ? "ciclos" : "faltas_llc");
+            if(perfil.descritores[k] < 0 || f == FASE_ESCRITA)
+               fputs("null", stderr);
+            else
+               fprintf(stderr, "%" PRIu64, perfil.eventos[k][f]);
+         }
+         fputc('}', stderr);
+      }
+      fprintf(stderr, "}, \"passos\": %lu, \"avaliacoes\": %lu, "
+         "\"ns_por_corpo_passo\": %.4g, \"quadros\": %lu, "
+         "\"descartados\": %lu, \"conferencias\": %lu, "
+         "\"salvamentos\": %lu, \"bytes\": %" PRIu64 "}\n",
+         perfil.passos, avaliacoes, perfil.corpos > 0.0 ?
+            1e9 * tempo[FASE_PASSOS] / perfil.corpos : 0.0,
+         perfil.quadros, descartados, perfil.conferencias,
+         perfil.salvamentos, bytes);
+      fflush(stderr);
+      return;
+   }
+
+   fprintf(stderr, "# perfil em %.3f s\n# %-12s %12s %7s %16s %14s\n",
+      total, "fase", "segundos", "%", "ciclos", "faltas LLC");
+   for(f = 0; f < FASES; ++f){
+      fprintf(stderr, "# %-12s %12.6f %6.2f%%", nomes_fases[f], tempo[f],
+         total > 0.0 ? 100.0 * tempo[f] / total : 0.0);
+      for(k = 0; k < 2; ++k){
+         if(perfil.descritores[k] < 0 || f == FASE_ESCRITA)
+            fprintf(stderr, " %*s", k == 0 ? 16 : 14, "-");
+         else
+            fprintf(stderr, " %*" PRIu64, k == 0 ? 16 : 14,
+               perfil.eventos[k][f]);
+      }
+      fputc('\n', stderr);
+   }
+   fprintf(stderr, "# passos %lu, avalia" "\xC3\xA7\xC3\xB5" "es %lu, "
+      "%.4g ns por corpo e passo\n", perfil.passos, avaliacoes,
+      perfil.corpos > 0.0 ? 1e9 * tempo[FASE_PASSOS] / perfil.corpos : 0.0);
+   fprintf(stderr, "# quadros %lu (%lu descartados), confer" "\xC3\xAA"
+      "ncias %lu, salvamentos %lu, %" PRIu64 " bytes escritos\n",
+      perfil.quadros, descartados, perfil.conferencias, perfil.salvamentos,
+      bytes);
+   fflush(stderr);
+}
+
+static void perfil_quadro(void){
+   ++perfil.quadros;
+   if(perfil.a_cada > 0UL && perfil.quadros % perfil.a_cada == 0UL)
+      perfil_relatar();
+}
+
+static void perfil_terminar(void){
+   int k;
+
+   perfil_relatar();
+   for(k = 0; k < 2; ++k)
+      if(perfil.descritores[k] >= 0) close(perfil.descritores[k]);
+}
+
+/* CLASSICO_PERFIL=[texto|json][,K] escolhe o formato do relatorio e o
+   intervalo, em quadros, dos relatorios parciais. */
+static void perfil_iniciar(void){
+   const char *opcao = getenv("CLASSICO_PERFIL"), *virgula;
+   int k;
+
+   if(opcao != NULL){
+      perfil.json = (strncmp(opcao, "json", 4) == 0);
+      virgula = strchr(opcao, ',');
+      if(virgula != NULL) perfil.a_cada = strtoul(virgula + 1, NULL, 10);
+   }
+   for(k = 0; k < 2; ++k){
+      perfil.descritores[k] = perfil_contador(k);
+      if(perfil.descritores[k] >= 0 && read(perfil.descritores[k],
+         perfil.contadores + k, sizeof(*perfil.contadores)) !=
+         (ssize_t)sizeof(*perfil.contadores)){
+         close(perfil.descritores[k]);
+         perfil.descritores[k] = -1;
+      }
+   }
+   perfil.inicio = perfil.marca = perfil_agora();
+   perfil.pilha[0] = FASE_OUTROS;
+   perfil.topo = 0;
+   atexit(perfil_terminar);
+}
+#endif
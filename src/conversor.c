@@ -0,0 +1,180 @@
+/* *****************************************************************************
+   Copyright (c) 2025 I.F.F. dos Santos <ismaellxd@gmail.com>
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the “Software”), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trajetoria.h"
+#include "cadeia.h"
+/* ---
+   Converte a trajetoria binaria escrita por `classico -b` para o formato
+   de texto que `classico` escreve na saida padrao, uma realizacao por vez.
+   Com `-c` faz o caminho contrario para a entrada: converte a descricao
+   da cadeia em texto para o formato binario de `cadeia.h`.
+--- */
+
+#define SIZE_C(x) ((size_t)(x))
+
+static int converter_cadeia(const char *entrada, const char *saida){
+   cabecalho_cadeia cabecalho;
+   FILE *arquivo;
+   char linha[1024];
+   double *colunas = NULL, *novas, x[4];
+   size_t N = SIZE_C(0), capacidade = SIZE_C(0), n, k;
+   int lidos, fim;
+
+   arquivo = fopen(entrada, "r");
+   if(arquivo == NULL){
+      fprintf(stderr, "ERRO: N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+         "abrir %s para leitura.\n", entrada);
+      return EXIT_FAILURE;
+   }
+   /* as colunas ficam intercaladas por linha ate N ser conhecido */
+   while(fgets(linha, (int)sizeof(linha), arquivo) != NULL){
+      fim = 0;
+      lidos = sscanf(linha, "%lf %lf %lf %lf %n",
+         &x[0], &x[1], &x[2], &x[3], &fim);
+      if(lidos != 4 || linha[fim] != '\0'){
+         fprintf(stderr, "ERRO: A linha %zu de %s n" "\xC3\xA3" "o tem "
+            "quatro n" "\xC3\xBA" "meros.\n", N + 1, entrada);
+         free(colunas);
+         fclose(arquivo);
+         return EXIT_FAILURE;
+      }
+      if(N == capacidade){
+         capacidade = (capacidade ? 2 * capacidade : SIZE_C(1024));
+         novas = realloc(colunas, 4 * capacidade * sizeof(*colunas));
+         if(novas == NULL){
+            fputs("ERRO: N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente "
+               "mem" "\xC3\xB3" "ria.\n", stderr);
+            free(colunas);
+            fclose(arquivo);
+            return EXIT_FAILURE;
+         }
+         colunas = novas;
+      }
+      memcpy(colunas + 4 * N, x, sizeof(x));
+      ++N;
+   }
+   fclose(arquivo);
+
+   arquivo = fopen(saida, "wb");
+   if(arquivo == NULL){
+      fprintf(stderr, "ERRO: N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+         "abrir %s para escrita.\n", saida);
+      free(colunas);
+      return EXIT_FAILURE;
+   }
+   memset(&cabecalho, 0, sizeof(cabecalho));
+   memcpy(cabecalho.magica, CADEIA_MAGICA, sizeof(CADEIA_MAGICA));
+   cabecalho.versao = CADEIA_VERSAO;
+   cabecalho.tipo = CADEIA_DOUBLE;
+   cabecalho.N = (uint64_t)N;
+   lidos = (fwrite(&cabecalho, sizeof(cabecalho), SIZE_C(1), arquivo) == 1);
+   for(k = SIZE_C(0); k < SIZE_C(4); ++k)
+      for(n = SIZE_C(0); lidos && n < N; ++n)
+         lidos = (fwrite(colunas + 4 * n + k, sizeof(*colunas), SIZE_C(1),
+            arquivo) == 1);
+   free(colunas);
+   if(fclose(arquivo) != 0 || !lidos){
+      fprintf(stderr, "ERRO: Falha ao escrever %s.\n", saida);
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv){
+   cabecalho_trajetoria cabecalho;
+   FILE *arquivo;
+   double t, *quadro;
+   size_t N, R, r, n;
+
+   if(argc > 3 && strcmp(argv[1], "-c") == 0)
+      return converter_cadeia(argv[2], argv[3]);
+
+   if(argc < 2){
+      fputs("ERRO: Argumentos inv" "\xc3\xa1" "lidos.\n", stderr);
+      fprintf(stderr, "%s [arquivo] <realiza" "\xC3\xA7\xC3\xA3" "o>\n", argv[0]);
+      fprintf(stderr, "%s -c [cadeia.txt] [cadeia.bin]\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   arquivo = fopen(argv[1], "rb");
+   if(arquivo == NULL){
+      fputs(
+         "ERRO: "
+         "N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+         "abrir o arquivo para leitura.\n",
+         stderr
+      );
+      return EXIT_FAILURE;
+   }
+
+   if(
+      fread(&cabecalho, sizeof(cabecalho), SIZE_C(1), arquivo) != SIZE_C(1) ||
+      memcmp(cabecalho.magica, TRAJETORIA_MAGICA, sizeof(TRAJETORIA_MAGICA)) ||
+      cabecalho.versao != TRAJETORIA_VERSAO ||
+      cabecalho.tipo != TRAJETORIA_DOUBLE
+   ){
+      fputs("ERRO: O arquivo n" "\xC3\xA3" "o " "\xC3\xA9" " uma "
+         "trajet" "\xC3\xB3" "ria bin" "\xC3\xA1" "ria v" "\xC3\xA1" "lida.\n",
+         stderr);
+      fclose(arquivo);
+      return EXIT_FAILURE;
+   }
+   N = (size_t)cabecalho.N;
+   R = (size_t)cabecalho.R;
+   r = (argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : SIZE_C(0));
+   if(r >= R){
+      fprintf(stderr, "ERRO: A trajet" "\xC3\xB3" "ria tem apenas %zu "
+         "realiza" "\xC3\xA7\xC3\xB5" "es.\n", R);
+      fclose(arquivo);
+      return EXIT_FAILURE;
+   }
+
+   quadro = malloc(2 * N * R * sizeof(*quadro));
+   if(quadro == NULL){
+      fputs(
+         "ERRO: "
+         "N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente mem" "\xC3\xB3" "ria.\n",
+         stderr
+      );
+      fclose(arquivo);
+      return EXIT_FAILURE;
+   }
+
+   /* cada quadro: t, Q[N * R], P[N * R] */
+   while(
+      fread(&t, sizeof(t), SIZE_C(1), arquivo) == SIZE_C(1) &&
+      fread(quadro, sizeof(*quadro), 2 * N * R, arquivo) == 2 * N * R
+   ){
+      for(n = SIZE_C(0); n < N; ++n){
+         fprintf(stdout, "%g %u %g %g\n",
+            t, (unsigned)n, quadro[n*R + r], quadro[N*R + n*R + r]);
+      }
+      fprintf(stdout, "\n");
+   }
+
+   free(quadro);
+   fclose(arquivo);
+   return EXIT_SUCCESS;
+}
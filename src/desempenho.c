@@ -0,0 +1,564 @@
+/* *****************************************************************************
+   Copyright (c) 2025 I.F.F. dos Santos <ismaellxd@gmail.com>
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the “Software”), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+***************************************************************************** */
+#define _GNU_SOURCE /* sched_setaffinity e sched_getcpu */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include "rede.h"
+#define PVI_CORPUS real
+#include "pvi.h"
+/* ---
+   Mede o desempenho dos integradores de `pvi.h` (os metodos do contexto
+   e as macros de multipasso, ver `multipassos`) e dos nucleos de
+   `classico` (ver rede.h) numa cadeia desordenada de N corpos (massas e
+   molas sorteadas entre 0.5 e 1.5, ponta esquerda livre, mola presa a
+   parede na direita e estado inicial sorteado), com N = 10^a ... 10^b
+   (opcao -n a:b). Cada medida comeca por um aquecimento, que integra de 0
+   ate o tempo final da opcao -t, da o erro da energia nesse instante e
+   escolhe quantas vezes repetir a integracao para que cada tentativa dure
+   ao menos os segundos da opcao -m. Seguem as tentativas da opcao -k, de
+   onde saem a mediana, o minimo, o maximo e a dispersao (o desvio absoluto
+   mediano sobre a mediana). Uma linha por medida, em CSV na saida padrao
+   e tambem em JSON com a opcao -j:
+      grupo: `nucleo` (uma varredura de arrastar ou chutar) ou `integrador`;
+      nome, simd, precisao: o que foi medido, os nucleos e o tipo real;
+      N, repeticoes: corpos e repeticoes por tentativa;
+      ns, ns_min, ns_max, dispersao: nanossegundos por corpo por passo (ou
+         por varredura);
+      banda: GB/s efetivos, contando so o trafego minimo, Q e P lidos e
+         escritos e kappa e 1/m lidos em cada passo, ou 4 numeros por corpo
+         numa varredura;
+      avaliacoes: varreduras do campo por segundo (`evaluationes` do
+         contexto, cada subpasso nos simpleticos);
+      erro: |H(t) - H(0)| / |H(0)| no tempo final, vazio nos nucleos.
+   O processo fica preso ao processador em que comecou (ou ao da opcao -c);
+   com OpenMP a afinidade fica por conta de OMP_PROC_BIND e OMP_PLACES.
+   Medidas que nao cabem em 3/4 da memoria fisica sao puladas.
+--- */
+
+typedef struct {
+   rede s; /* kappa[-1] = 0, como em classico */
+   size_t N;
+   real *memoria, *estado;
+} cadeia;
+
+typedef struct {
+   const char *grupo, *nome, *simd;
+   size_t N;
+   unsigned long repeticoes;
+   double ns, minimo, maximo, dispersao, banda, avaliacoes, erro;
+} medida;
+
+/* gerador xorshift64*, a mesma cadeia em todas as execucoes */
+static uint64_t semente;
+static double sortear(void){
+   semente ^= semente >> 12;
+   semente ^= semente << 25;
+   semente ^= semente >> 27;
+   return (double)((semente * UINT64_C(2685821657736338717)) >> 11) *
+      (1.0 / 9007199254740992.0);
+}
+
+/* Sorteia a cadeia e o estado inicial. Com `bordas` Q e P ficam como em
+   classico (Q com um zero de cada lado), sem elas o estado eh o vetor
+   contiguo (Q, P) dos metodos nao simpleticos. */
+static void sortear_cadeia(cadeia *c, int bordas, real **Q, real **P){
+   const size_t N = c->N;
+   size_t n;
+
+   semente = UINT64_C(88172645463325252);
+   c->s.kappa[-1] = 0.0;
+   for(n = SIZE_C(0); n < N; ++n){
+      c->s.kappa[n] = (real)(0.5 + sortear());
+      c->s.inv_massa[n] = (real)(1.0 / (0.5 + sortear()));
+   }
+   *Q = c->estado + (bordas ? 1 : 0);
+   *P = *Q + N + (bordas ? 1 : 0);
+   if(bordas) c->estado[0] = (*Q)[N] = 0.0;
+   for(n = SIZE_C(0); n < N; ++n){
+      (*Q)[n] = (real)(0.2 * sortear() - 0.1);
+      (*P)[n] = (real)(0.2 * sortear() - 0.1);
+   }
+}
+
+/* Energia com soma compensada, a parede direita prende o ultimo corpo. */
+static acumulador energia(const cadeia *c, const real *Q, const real *P){
+   acumulador H = 0.0, compensacao = 0.0, e, y, t, d;
+   size_t n;
+
+   for(n = SIZE_C(0); n < c->N; ++n){
+      d = (n + 1 < c->N ? (acumulador)Q[n + 1] : 0.0) - Q[n];
+      e = 0.5 * c->s.kappa[n] * d * d +
+         0.5 * (acumulador)P[n] * P[n] * c->s.inv_massa[n];
+      y = e - compensacao;
+      t = H + y;
+      compensacao = (t - H) - y;
+      H = t;
+   }
+   return H;
+}
+
+/* Campo (dQ/dt, dP/dt) no vetor X = (Q, P), para os metodos nao
+   simpleticos, com as mesmas contas de `dot_Q` e `dot_P`. */
+static void campo(size_t a, size_t b, double t,
+   real *X, real *F, void *data){
+   const cadeia *c = data;
+   const size_t N = c->N;
+   const real *Q = X, *P = X + N, *kappa = c->s.kappa;
+   size_t n, m;
+
+   (void)t;
+   for(n = a; n < b && n < N; ++n) F[n] = P[n] * c->s.inv_massa[n];
+   for(n = (a > N ? a : N); n < b; ++n){
+      m = n - N;
+      F[n] = kappa[m] * ((m + 1 < N ? Q[m + 1] : 0.0) - Q[m])
+         - kappa[m - 1] * (Q[m] - (m > SIZE_C(0) ? Q[m - 1] : 0.0));
+   }
+}
+
+static double agora(void){
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return (double)t.tv_sec + 1e-9 * (double)t.tv_nsec;
+}
+
+static int comparar(const void *a, const void *b){
+   const double x = *(const double*)a, y = *(const double*)b;
+   return (x > y) - (x < y);
+}
+
+/* Mediana, extremos e dispersao de k tempos, que sao reordenados. */
+static void resumir(medida *m, double *tempos, int k){
+   double *desvios = tempos + k;
+   int i;
+
+   qsort(tempos, (size_t)k, sizeof(*tempos), comparar);
+   m->minimo = tempos[0];
+   m->maximo = tempos[k - 1];
+   m->ns = 0.5 * (tempos[(k - 1) / 2] + tempos[k / 2]);
+   for(i = 0; i < k; ++i) desvios[i] = fabs(tempos[i] - m->ns);
+   qsort(desvios, (size_t)k, sizeof(*desvios), comparar);
+   m->dispersao = 0.5 * (desvios[(k - 1) / 2] + desvios[k / 2]) / m->ns;
+}
+
+static FILE *json;
+static int linhas;
+static void publicar(const medida *m){
+   printf("%s,%s,%s,%s,%zu,%lu,%.4g,%.4g,%.4g,%.4g,%.4g,%.4g,",
+      m->grupo, m->nome, m->simd, REAL_NOME, m->N, m->repeticoes, m->ns,
+      m->minimo, m->maximo, m->dispersao, m->banda, m->avaliacoes);
+   if(m->erro == m->erro) printf("%.3e", m->erro);
+   printf("\n");
+   fflush(stdout);
+   if(json == NULL) return;
+   fprintf(json, "%s\n  {\"grupo\": \"%s\", \"nome\": \"%s\", "
+      "\"simd\": \"%s\", \"precisao\": \"%s\", \"N\": %zu, "
+      "\"repeticoes\": %lu, \"ns\": %.4g, \"ns_min\": %.4g, "
+      "\"ns_max\": %.4g, \"dispersao\": %.4g, \"banda\": %.4g, "
+      "\"avaliacoes\": %.4g, \"erro\": ", linhas++ ? "," : "[",
+      m->grupo, m->nome, m->simd, REAL_NOME, m->N, m->repeticoes, m->ns,
+      m->minimo, m->maximo, m->dispersao, m->banda, m->avaliacoes);
+   /* JSON nao tem NaN nem infinito */
+   if(isfinite(m->erro)) fprintf(json, "%.3e}", m->erro);
+   else fprintf(json, "null}");
+}
+
+static int tentativas = 5;
+static double minimo_tentativa = 0.2, tempo_final = 1.0, passo = 0.0625;
+static double tolerancia = 1e-8;
+static double *tempos;
+
+/* Uma varredura de cada nucleo disponivel. */
+static void medir_nucleos(cadeia *c){
+   const size_t N = c->N;
+   nucleo nucleos[2];
+   const char *const nomes[2] = { "arrastar", "chutar" };
+   medida m;
+   real *Q, *P;
+   unsigned long r;
+   double inicio, duracao;
+   int nivel, j, k;
+
+   sortear_cadeia(c, 1, &Q, &P);
+   for(nivel = 0; nivel < 4; ++nivel){
+      setenv("CLASSICO_SIMD", nomes_nucleos[nivel], 1);
+      if(escolher_nucleos(nucleos, nucleos + 1) != nivel) continue;
+      for(j = 0; j < 2; ++j){
+         /* o passo minusculo deixa o estado praticamente parado */
+         inicio = agora();
+         if(j == 0) nucleos[0](SIZE_C(0), N, 1e-9, Q, P, &c->s);
+         else nucleos[1](SIZE_C(0), N, 1e-9, P, Q, &c->s);
+         duracao = agora() - inicio;
+         m.repeticoes = (unsigned long)ceil(minimo_tentativa /
+            (duracao > 1e-7 ? duracao : 1e-7));
+         for(k = 0; k < tentativas; ++k){
+            inicio = agora();
+            for(r = 0UL; r < m.repeticoes; ++r){
+               if(j == 0) nucleos[0](SIZE_C(0), N, 1e-9, Q, P, &c->s);
+               else nucleos[1](SIZE_C(0), N, 1e-9, P, Q, &c->s);
+            }
+            tempos[k] = 1e9 * (agora() - inicio) /
+               ((double)m.repeticoes * (double)N);
+         }
+         m.grupo = "nucleo";
+         m.nome = nomes[j];
+         m.simd = nomes_nucleos[nivel];
+         m.N = N;
+         resumir(&m, tempos, tentativas);
+         m.banda = 4.0 * (double)sizeof(real) / m.ns;
+         m.avaliacoes = 1e9 / (m.ns * (double)N);
+         m.erro = NAN;
+         publicar(&m);
+      }
+   }
+   unsetenv("CLASSICO_SIMD");
+}
+
+/* Integra de 0 ate o tempo final a partir do estado sorteado, devolve
+   a duracao ou um valor negativo se o metodo falhar. */
+static double integrar(pvi_contextus *contexto, cadeia *c, int simpletico){
+   const int variavel = (contexto->methodus == PVI_DOPRI5 ||
+      contexto->methodus == PVI_ABM_VARIABILIS ||
+      contexto->methodus == PVI_KRYLOV);
+   const double limite = (variavel ? tempo_final : tempo_final - 0.5 * passo);
+   real *Q, *P;
+   double inicio;
+
+   sortear_cadeia(c, simpletico, &Q, &P);
+   contexto->x = Q;
+   contexto->y = P;
+   contexto->tempus = 0.0;
+   contexto->h = passo;
+   contexto->terminus = tempo_final;
+   pvi_obliviscere(contexto);
+   inicio = agora();
+   while(contexto->tempus < limite)
+      if(pvi_progredere(contexto) != 0) return -1.0;
+   return agora() - inicio;
+}
+
+static void medir_integrador(cadeia *c, int metodo, double memoria){
+   const size_t N = c->N;
+   const int simpletico = (metodo >= PVI_EULER_S);
+   pvi_contextus *contexto;
+   unsigned long passos, avaliacoes, r;
+   medida m;
+   real *Q, *P;
+   acumulador E;
+   double duracao, soma;
+   int k;
+
+   m.grupo = "integrador";
+   m.nome = pvi_nomen(metodo);
+   m.N = N;
+   contexto = pvi_crea(metodo, simpletico ? N : 2 * N, passo);
+   if(contexto == NULL || (double)contexto->arena.magnitudo > memoria){
+      fprintf(stderr, "AVISO: %s com N = %zu n" "\xC3\xA3" "o cabe na "
+         "mem" "\xC3\xB3" "ria.\n", m.nome, N);
+      pvi_destrue(contexto);
+      return;
+   }
+   contexto->tolerantia_absoluta = contexto->tolerantia_relativa = tolerancia;
+   if(simpletico){
+      m.simd = nomes_nucleos[escolher_nucleos(&contexto->gradus_X,
+         &contexto->gradus_Y)];
+      contexto->data = &c->s;
+      contexto->fusus = 1;
+   }else{
+      m.simd = nomes_nucleos[0];
+      contexto->campus = campo;
+      contexto->data = c;
+   }
+
+   /* aquecimento, que tambem da o erro da energia no tempo final */
+   sortear_cadeia(c, simpletico, &Q, &P);
+   E = energia(c, Q, P);
+   contexto->acceptati = contexto->evaluationes = 0UL;
+   duracao = integrar(contexto, c, simpletico);
+   if(duracao < 0.0){
+      fprintf(stderr, "AVISO: %s falhou com N = %zu.\n", m.nome, N);
+      pvi_destrue(contexto);
+      return;
+   }
+   passos = contexto->acceptati;
+   avaliacoes = contexto->evaluationes;
+   m.erro = fabs((double)((energia(c, contexto->x,
+      simpletico ? contexto->y : contexto->x + N) - E) / E));
+   m.repeticoes = (unsigned long)ceil(minimo_tentativa /
+      (duracao > 1e-7 ? duracao : 1e-7));
+
+   /* o sorteio do estado fica fora da medida */
+   for(k = 0; k < tentativas; ++k){
+      for(r = 0UL, soma = 0.0; r < m.repeticoes; ++r)
+         soma += integrar(contexto, c, simpletico);
+      tempos[k] = 1e9 * soma /
+         ((double)m.repeticoes * (double)passos * (double)N);
+   }
+   pvi_destrue(contexto);
+   resumir(&m, tempos, tentativas);
+   m.banda = 6.0 * (double)sizeof(real) / m.ns;
+   m.avaliacoes = (double)avaliacoes /
+      (1e-9 * m.ns * (double)passos * (double)N);
+   publicar(&m);
+}
+
+/* Os metodos de multipasso de passo fixo so existem como as macros
+   PVI_INTEGRATOR_AB* e PVI_INTEGRATOR_ABM* de `pvi.h`, que avaliam o campo
+   um indice por vez em X = (Q, P). A cadeia vai por `cadeia_macro` e as
+   varreduras do campo sao contadas no indice 0, que com OpenMP fica
+   sempre com a mesma thread. */
+static const cadeia *cadeia_macro;
+static unsigned long avaliacoes_macro;
+static inline real derivada(size_t n, const real *X){
+   const size_t N = cadeia_macro->N;
+   const real *kappa = cadeia_macro->s.kappa;
+   size_t m;
+
+   if(n == SIZE_C(0)) ++avaliacoes_macro;
+   if(n < N) return X[N + n] * cadeia_macro->s.inv_massa[n];
+   m = n - N;
+   return kappa[m] * ((m + 1 < N ? X[m + 1] : 0.0) - X[m])
+      - kappa[m - 1] * (X[m] - (m > SIZE_C(0) ? X[m - 1] : 0.0));
+}
+#define DERIVADA(n, t, X) derivada(n, X)
+
+/* Integra X de 0 ate pvi_finalis, devolve a duracao ou um valor negativo
+   se a macro falhar (ver pvi_defectus). */
+#define MULTIPASSO(funcao, INTEGRADOR) \
+static double funcao(real *X){\
+   double t = 0.0, inicio = agora();\
+   INTEGRADOR(t, X, DERIVADA);\
+   return (pvi_defectus ? -1.0 : agora() - inicio);\
+}
+MULTIPASSO(integrar_ab2, PVI_INTEGRATOR_AB2)
+MULTIPASSO(integrar_ab3, PVI_INTEGRATOR_AB3)
+MULTIPASSO(integrar_ab4, PVI_INTEGRATOR_AB4)
+MULTIPASSO(integrar_ab5, PVI_INTEGRATOR_AB5)
+MULTIPASSO(integrar_ab10, PVI_INTEGRATOR_AB10)
+MULTIPASSO(integrar_abm1, PVI_INTEGRATOR_ABM1)
+MULTIPASSO(integrar_abm2, PVI_INTEGRATOR_ABM2)
+MULTIPASSO(integrar_abm3, PVI_INTEGRATOR_ABM3)
+MULTIPASSO(integrar_abm4, PVI_INTEGRATOR_ABM4)
+MULTIPASSO(integrar_abm5, PVI_INTEGRATOR_ABM5)
+MULTIPASSO(integrar_abm10, PVI_INTEGRATOR_ABM10)
+
+/* nome, integracao e vetores de tamanho 2N de cada macro */
+static const struct {
+   const char *nome;
+   double (*integrar)(real*);
+   int vetores;
+} multipassos[] = {
+   { "ab2", integrar_ab2, 2 }, { "ab3", integrar_ab3, 3 },
+   { "ab4", integrar_ab4, 4 }, { "ab5", integrar_ab5, 5 },
+   { "ab10", integrar_ab10, 10 }, { "abm1", integrar_abm1, 2 },
+   { "abm2", integrar_abm2, 3 }, { "abm3", integrar_abm3, 4 },
+   { "abm4", integrar_abm4, 5 }, { "abm5", integrar_abm5, 6 },
+   { "abm10", integrar_abm10, 11 }
+};
+#define MULTIPASSOS ((int)(sizeof(multipassos) / sizeof(*multipassos)))
+
+/* Devolve a macro chamada `nome`, ou -1. */
+static int multipasso(const char *nome){
+   int k;
+   for(k = 0; k < MULTIPASSOS; ++k)
+      if(strcmp(nome, multipassos[k].nome) == 0) return k;
+   return -1;
+}
+
+static void medir_multipasso(cadeia *c, int k, double memoria){
+   const size_t N = c->N;
+   unsigned long passos, avaliacoes, r;
+   medida m;
+   real *Q, *P;
+   acumulador E;
+   double duracao, soma;
+   int j;
+
+   m.grupo = "integrador";
+   m.nome = multipassos[k].nome;
+   m.simd = nomes_nucleos[0];
+   m.N = N;
+   /* as inclinacoes e o espaco de trabalho do RK2 que comeca a macro */
+   if((double)(multipassos[k].vetores + 4) * (double)(2 * N) *
+      (double)sizeof(real) > memoria){
+      fprintf(stderr, "AVISO: %s com N = %zu n" "\xC3\xA3" "o cabe na "
+         "mem" "\xC3\xB3" "ria.\n", m.nome, N);
+      return;
+   }
+   cadeia_macro = c;
+   pvi_dimensio = 2 * N;
+   pvi_h = passo;
+   pvi_finalis = tempo_final;
+
+   /* aquecimento, que tambem da o erro da energia no tempo final */
+   sortear_cadeia(c, 0, &Q, &P);
+   E = energia(c, Q, P);
+   avaliacoes_macro = 0UL;
+   duracao = multipassos[k].integrar(Q);
+   if(duracao < 0.0){
+      fprintf(stderr, "AVISO: %s falhou com N = %zu.\n", m.nome, N);
+      return;
+   }
+   passos = (unsigned long)ceil(tempo_final / passo - 1e-9);
+   avaliacoes = avaliacoes_macro;
+   m.erro = fabs((double)((energia(c, Q, Q + N) - E) / E));
+   m.repeticoes = (unsigned long)ceil(minimo_tentativa /
+      (duracao > 1e-7 ? duracao : 1e-7));
+
+   /* o sorteio do estado fica fora da medida */
+   for(j = 0; j < tentativas; ++j){
+      for(r = 0UL, soma = 0.0; r < m.repeticoes; ++r){
+         sortear_cadeia(c, 0, &Q, &P);
+         soma += multipassos[k].integrar(Q);
+      }
+      tempos[j] = 1e9 * soma /
+         ((double)m.repeticoes * (double)passos * (double)N);
+   }
+   resumir(&m, tempos, tentativas);
+   m.banda = 6.0 * (double)sizeof(real) / m.ns;
+   m.avaliacoes = (double)avaliacoes /
+      (1e-9 * m.ns * (double)passos * (double)N);
+   publicar(&m);
+}
+
+/* Prende o processo a um processador, o atual se cpu < 0. */
+static int prender(int cpu){
+#if defined(__linux__) && !defined(_OPENMP)
+   cpu_set_t conjunto;
+
+   if(cpu < 0) cpu = sched_getcpu();
+   if(cpu < 0) return 1;
+   CPU_ZERO(&conjunto);
+   CPU_SET(cpu, &conjunto);
+   return sched_setaffinity(0, sizeof(conjunto), &conjunto) != 0;
+#else
+   (void)cpu;
+   return 0;
+#endif
+}
+
+int main(int argc, char **argv){
+   cadeia c;
+   const char *nome_json = NULL, *nome;
+   double memoria;
+   size_t N;
+   int opcao, metodo, a = 3, b = 8, e, cpu = -1, k;
+
+   while((opcao = getopt(argc, argv, "c:e:h:j:k:m:n:t:")) != -1){
+      if(opcao == 'c') cpu = atoi(optarg);
+      else if(opcao == 'e') tolerancia = atof(optarg);
+      else if(opcao == 'h') passo = atof(optarg);
+      else if(opcao == 'j') nome_json = optarg;
+      else if(opcao == 'k') tentativas = atoi(optarg);
+      else if(opcao == 'm') minimo_tentativa = atof(optarg);
+      else if(opcao == 'n'){
+         if(sscanf(optarg, "%d:%d", &a, &b) == 1) b = a;
+      }else if(opcao == 't') tempo_final = atof(optarg);
+      else{
+         fprintf(stderr, "%s [-n menor:maior expoente de N] [-k tentativas] "
+            "[-m segundos por tentativa] [-t tempo final] [-h passo] "
+            "[-e toler" "\xC3\xA2" "ncia] [-c processador] [-j arquivo] "
+            "[esquema]...\n", argv[0]);
+         return EXIT_FAILURE;
+      }
+   }
+   if(a < 1 || b < a || b > 12 || tentativas < 1 || !(passo > 0.0) ||
+      !(tempo_final >= passo)){
+      fputs("ERRO: Argumentos inv" "\xC3\xA1" "lidos.\n", stderr);
+      return EXIT_FAILURE;
+   }
+   for(k = optind; k < argc; ++k){
+      if(pvi_methodus(argv[k]) < 0 && multipasso(argv[k]) < 0){
+         fprintf(stderr, "ERRO: M" "\xC3\xA9" "todo desconhecido: %s.\n",
+            argv[k]);
+         return EXIT_FAILURE;
+      }
+   }
+   if(prender(cpu) != 0)
+      fputs("AVISO: N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel prender o "
+         "processo a um processador.\n", stderr);
+   if(nome_json != NULL && (json = fopen(nome_json, "w")) == NULL){
+      fprintf(stderr, "ERRO: N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+         "abrir %s para escrita.\n", nome_json);
+      return EXIT_FAILURE;
+   }
+   memoria = 0.75 * (double)sysconf(_SC_PHYS_PAGES) *
+      (double)sysconf(_SC_PAGESIZE);
+   tempos = malloc(2 * (size_t)tentativas * sizeof(*tempos));
+   if(tempos == NULL){
+      fputs("ERRO: N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente "
+         "mem" "\xC3\xB3" "ria.\n", stderr);
+      return EXIT_FAILURE;
+   }
+
+   printf("grupo,nome,simd,precisao,N,repeticoes,ns,ns_min,ns_max,"
+      "dispersao,banda,avaliacoes,erro\n");
+   for(e = a; e <= b; ++e){
+      N = SIZE_C(1);
+      for(k = 0; k < e; ++k) N *= SIZE_C(10);
+      c.N = N;
+      c.memoria = NULL;
+      if((double)(4 * N + 3) * (double)sizeof(real) <= memoria)
+         c.memoria = malloc((4 * N + 3) * sizeof(real));
+      if(c.memoria == NULL){
+         fprintf(stderr, "AVISO: A cadeia com N = %zu n" "\xC3\xA3" "o "
+            "cabe na mem" "\xC3\xB3" "ria.\n", N);
+         break;
+      }
+      c.s.R = SIZE_C(1);
+      c.s.kappa = c.memoria + 1;
+      c.s.inv_massa = c.s.kappa + N;
+      c.estado = c.s.inv_massa + N;
+      memoria -= (double)(4 * N + 3) * (double)sizeof(real);
+
+      medir_nucleos(&c);
+      for(metodo = 0; (nome = pvi_nomen(metodo)) != NULL; ++metodo){
+         for(k = optind; k < argc && strcmp(argv[k], nome) != 0; ++k);
+         if(optind < argc && k == argc) continue;
+         medir_integrador(&c, metodo, memoria);
+      }
+      for(metodo = 0; metodo < MULTIPASSOS; ++metodo){
+         nome = multipassos[metodo].nome;
+         for(k = optind; k < argc && strcmp(argv[k], nome) != 0; ++k);
+         if(optind < argc && k == argc) continue;
+         medir_multipasso(&c, metodo, memoria);
+      }
+      pvi_libera();
+      memoria += (double)(4 * N + 3) * (double)sizeof(real);
+      free(c.memoria);
+   }
+   free(tempos);
+   if(json != NULL){
+      fprintf(json, "%s\n]\n", linhas ? "" : "[");
+      if(ferror(json) | fclose(json)){
+         fputs("ERRO: Falha ao escrever o JSON.\n", stderr);
+         return EXIT_FAILURE;
+      }
+   }
+   return EXIT_SUCCESS;
+}
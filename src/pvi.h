@@ -38,13 +38,52 @@ extern "C" {
 # error "Utilize um compilador compativel com o ISO C."
 #endif /* __STDC__ */
 
+#include <math.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
+/* The type of the state may be chosen before including this header, for
+   example float, long double or __float128. Times, steps, coefficients and
+   error norms stay double whatever the choice. */
+#ifndef PVI_CORPUS
 #define PVI_CORPUS double
+#endif
+#define PVI__ABS(x) fabs((double)(x))
 #define PVI_FAC_ALIQUID()
 #define PVI_ALLOCARE() (PVI_CORPUS*)malloc(pvi_dimensio*sizeof(PVI_CORPUS))
 
+/* When compiled with OpenMP (-fopenmp) every sweep over the indices is
+   shared among the threads of the OpenMP pool, which is created once and
+   kept alive between sweeps. Each thread always receives the same contiguous
+   range of indices and no sum is split among threads, hence the results do
+   not depend on the number of threads. Sweeps over less than
+   PVI_PARALLELUS_MINIMUS indices are not worth waking the pool for. */
+#ifndef PVI_PARALLELUS_MINIMUS
+#define PVI_PARALLELUS_MINIMUS ((size_t)16384)
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#define PVI__PRAGMA(x) _Pragma(#x)
+#define PVI_PARALLELE_SI(n) PVI__PRAGMA(\
+   omp parallel for schedule(static) if((n) >= PVI_PARALLELUS_MINIMUS))
+#define PVI_PARALLELE PVI_PARALLELE_SI(pvi_dimensio)
+#define PVI_PARALLELUS_REGIO _Pragma("omp parallel num_threads(pvi_partes)")
+#define PVI_PARALLELUS_SYNCHRONIZA _Pragma("omp barrier")
+#define PVI_PARTES_MAXIMAE() ((size_t)omp_get_max_threads())
+#define PVI_PARTES() ((size_t)omp_get_num_threads())
+#define PVI_PARS() ((size_t)omp_get_thread_num())
+#else
+#define PVI_PARALLELE_SI(n)
+#define PVI_PARALLELE
+#define PVI_PARALLELUS_REGIO
+#define PVI_PARALLELUS_SYNCHRONIZA
+#define PVI_PARTES_MAXIMAE() ((size_t)1)
+#define PVI_PARTES() ((size_t)1)
+#define PVI_PARS() ((size_t)0)
+#endif
+
 /* For the value od pvi_h I recommend to use numbers that can be written as
    as um of term of the form k / 2 ** n where k and n are
    non-negative integers, for example:
@@ -56,129 +95,1901 @@ extern "C" {
    * 0.0625
    * 0.015625
    * 0.00390625
-   I also recommend pvi_finalis to be divisible by pvi_h. */
+   I also recommend pvi_finalis to be divisible by pvi_h. With the context
+   API the output times need not fall on the steps: pvi_interpola and
+   pvi_curre_densus give the state anywhere inside the last step, so the
+   step may be chosen for stability and accuracy alone. */
 
-static size_t pvi_dimensio = (size_t)1;
-static double pvi_h = 0.25, pvi_finalis = 1.0;
+#if defined(__GNUC__)
+#define PVI__INUTILIS __attribute__((unused))
+#define PVI__SEMPER __attribute__((always_inline))
+#else
+#define PVI__INUTILIS
+#define PVI__SEMPER
+#endif
+#define PVI_FUNCTIO static PVI__INUTILIS
+/* the loops generic over the block callbacks, always inlined so that a
+   callback known at the call site is called directly (see
+   pvi_progredere_campus) */
+#define PVI_INLINE static inline PVI__SEMPER PVI__INUTILIS
+
+static PVI__INUTILIS size_t pvi_dimensio = (size_t)1;
+static PVI__INUTILIS double pvi_h = 0.25, pvi_finalis = 1.0;
+/* absolute and relative tolerances of the methods with step control */
+static PVI__INUTILIS double pvi_tolerantia = 1e-6;
+/* accepted and rejected steps and evaluations of the field in the last
+   call of a macro built on the contexts (see pvi_contextus) */
+static PVI__INUTILIS unsigned long
+   pvi_acceptati = 0UL, pvi_rejecti = 0UL, pvi_evaluationes = 0UL;
+/* nonzero when the last call of such a macro did not integrate to
+   pvi_finalis: its context or the slopes of a multistep method could not
+   be allocated, or the method itself failed (see pvi_contextus) */
+static PVI__INUTILIS int pvi_defectus = 0;
 
 /* ------------------------------------
-   Metodos de Runge-Kutta
+   Memoria de trabalho
 ----------------------------------- */
 
-#define PVI_INTEGRATOR_EULER(t, X, X_punctum) \
-{\
-   size_t pvi_index;\
-   PVI_CORPUS *pvi_inclinatio = NULL;\
-\
-   pvi_inclinatio = PVI_ALLOCARE();\
-\
-   while(t < pvi_finalis){\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[pvi_index] = X_punctum(pvi_index, t, X);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (X)[pvi_index] += pvi_inclinatio[pvi_index] * pvi_h;\
-      t += pvi_h;\
-      PVI_FAC_ALIQUID();\
-   }\
-   free(pvi_inclinatio);\
+/* The stage and history arrays of a method are carved from a single arena,
+   allocated once and reused while it is large enough. The arena and every
+   array in it start at a multiple of PVI_ALINEAMENTUM bytes, a cache line,
+   which also suits the widest vector loads. When PVI_PAGINAE_MAGNAE is
+   defined and the system provides it, the arena is mapped with mmap and the
+   kernel is asked to back it with (transparent) huge pages, which saves TLB
+   misses in the sweeps over long arrays. */
+#ifndef PVI_ALINEAMENTUM
+#define PVI_ALINEAMENTUM ((size_t)64)
+#endif
+#ifdef PVI_PAGINAE_MAGNAE
+#include <sys/mman.h>
+#if !defined(MAP_ANONYMOUS) || !defined(MADV_HUGEPAGE)
+#undef PVI_PAGINAE_MAGNAE
+#endif
+#endif
+#ifndef PVI_PAGINA_MAGNA
+#define PVI_PAGINA_MAGNA ((size_t)2 << 20)
+#endif
+
+typedef struct {
+   void *basis; /* as returned by the allocator */
+   unsigned char *memoria; /* aligned start */
+   size_t magnitudo; /* usable bytes from memoria on */
+   size_t passus; /* bytes from one array to the next */
+} pvi_arena;
+
+PVI_FUNCTIO void pvi_arena_libera(pvi_arena *a){
+#ifdef PVI_PAGINAE_MAGNAE
+   if(a->basis != NULL) munmap(a->basis, a->magnitudo);
+#else
+   free(a->basis);
+#endif
+   a->basis = NULL;
+   a->memoria = NULL;
+   a->magnitudo = a->passus = (size_t)0;
 }
 
+/* Makes room for `partes` arrays of `dimensio` elements, reallocating only
+   when the arena is too small. Returns non-zero if there is not enough
+   memory, in which case the arena is left empty. */
+PVI_FUNCTIO int pvi_arena_para(pvi_arena *a, size_t partes, size_t dimensio){
+   const size_t A = PVI_ALINEAMENTUM;
+   size_t passus, magnitudo;
 
-#define PVI_INTEGRATOR_RK2(t, X, X_punctum) \
+   passus = (dimensio * sizeof(PVI_CORPUS) + A - (size_t)1) / A * A;
+   magnitudo = partes * passus;
+   a->passus = passus;
+   if(magnitudo <= a->magnitudo && a->basis != NULL) return 0;
+
+   pvi_arena_libera(a);
+   if(magnitudo == (size_t)0) return 0;
+#ifdef PVI_PAGINAE_MAGNAE
+   magnitudo = (magnitudo + PVI_PAGINA_MAGNA - (size_t)1) /
+      PVI_PAGINA_MAGNA * PVI_PAGINA_MAGNA;
+   a->basis = mmap(NULL, magnitudo, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+   if(a->basis == MAP_FAILED){
+      a->basis = NULL;
+      return -1;
+   }
+   madvise(a->basis, magnitudo, MADV_HUGEPAGE);
+   a->memoria = (unsigned char*)a->basis;
+#else
+   a->basis = malloc(magnitudo + A);
+   if(a->basis == NULL) return -1;
+   a->memoria = (unsigned char*)a->basis +
+      (A - (size_t)((uintptr_t)a->basis % A)) % A;
+#endif
+   a->magnitudo = magnitudo;
+   a->passus = passus;
+   return 0;
+}
+
+/* The array k of the arena. */
+PVI_FUNCTIO PVI_CORPUS *pvi_arena_pars(const pvi_arena *a, size_t k){
+   return (PVI_CORPUS*)(void*)(a->memoria + k * a->passus);
+}
+
+/* ------------------------------------
+   Interface reentrante
+----------------------------------- */
+
+/* The whole state of an integration lives in a pvi_contextus, created by
+   pvi_crea and released by pvi_destrue, so that several integrations can
+   run at the same time, each one in its own thread. After pvi_crea the
+   caller sets the initial time (tempus), the state (x, and y for the
+   symplectic methods), one form of the vector field and the pointer `data`
+   handed over to every callback:
+   * for PVI_EULER, PVI_RK2 and PVI_RK4, either punctum(n, t, X, data),
+     which returns the component n of the field, or the block form
+     campus(a, b, t, X, F, data), which writes F[n] for a <= n < b;
+   * for the symplectic methods, either punctum_X(n, Y, data) and
+     punctum_Y(n, X, data), or the block forms gradus_X(a, b, c, X, Y, data),
+     which must perform X[n] += c * punctum_X(n, Y, data) for a <= n < b,
+     and gradus_Y(a, b, c, Y, X, data). PVI_RUTH4_FUSUS, and any
+     symplectic method with fusus set, only accepts the block forms, and
+     blocus must not be smaller than the reach of the stencil of gradus_Y.
+   pvi_progredere advances one step of size h and pvi_curre integrates up
+   to a final time, while pvi_curre_densus also hands over the state at a
+   list of output times (see pvi_interpola). PVI_DOPRI5 and
+   PVI_ABM_VARIABILIS take the same callbacks as PVI_RK4, but choose their
+   own step (and the latter also its order): h is only the first trial
+   step, and afterwards the proposal for the next one, and the local error
+   of each step is kept below
+   tolerantia_absoluta + tolerantia_relativa * |x[n]| in every component.
+   PVI_KRYLOV also takes the same callbacks, but only for a linear and
+   autonomous field, f(t, X) = D X: each step is exp(h D) x, computed in
+   a Krylov subspace of at most PVI_KRYLOV_MAXIMUS vectors built by as many
+   evaluations of the field, grown until the estimated error of the step,
+   in Euclidean norm, is below tolerantia_absoluta * sqrt(dimensio) +
+   tolerantia_relativa * |x|. The basis is built by Arnoldi, or by the
+   Lanczos recurrence when symmetria tells that D is symmetric (1) or
+   antisymmetric (-1), as for the Schrodinger equation split into real and
+   imaginary parts. h is a trial step, shortened when the largest subspace
+   is not enough and lengthened when a smaller one is.
+   The counters acceptati, rejecti and evaluationes (sweeps of the field over
+   all the indices) are never reset by the library. The global variables
+   pvi_dimensio, pvi_h, pvi_finalis and pvi_tolerantia are only used by the
+   macros PVI_INTEGRATOR_*. */
+
+enum {
+   PVI_EULER, PVI_RK2, PVI_RK4, PVI_DOPRI5, PVI_ABM_VARIABILIS, PVI_KRYLOV,
+   PVI_EULER_S, PVI_VERLET, PVI_RUTH3, PVI_RUTH4, PVI_RUTH4_FUSUS,
+   PVI_YOSHIDA6, PVI_YOSHIDA8, PVI_BLANES_MOAN4, PVI_BLANES_MOAN6,
+   PVI_BLANES_MOAN_RKN4, PVI_BLANES_MOAN_RKN6,
+   PVI_SABA2, PVI_SABA3, PVI_SABA4, PVI_SBAB2, PVI_SBAB3, PVI_SBAB4,
+   PVI__METHODI
+};
+
+/* Highest order of PVI_ABM_VARIABILIS. */
+#ifndef PVI_ORDO_MAXIMUS
+#define PVI_ORDO_MAXIMUS 10
+#endif
+
+/* Largest Krylov subspace of PVI_KRYLOV. */
+#ifndef PVI_KRYLOV_MAXIMUS
+#define PVI_KRYLOV_MAXIMUS 30
+#endif
+
+/* Most sub-stages in one step of a symplectic method (PVI_YOSHIDA8). */
+#define PVI_STADIA_MAXIMA 31
+
+/* Evaluations of the field asked by pvi_pete:
+   * PVI_CAMPUS: F[n] = f(n, tempus, argumentum) for every n, and also
+     Z[n] = B[n] + F[n] * c when Z is not NULL;
+   * PVI_GRADUS_X: F[n] += punctum_X(n, argumentum) * c, F is the array x
+     of the context and argumentum is y;
+   * PVI_GRADUS_Y: F[n] += punctum_Y(n, argumentum) * c, with x and y
+     exchanged. */
+enum { PVI_CAMPUS, PVI_GRADUS_X, PVI_GRADUS_Y };
+
+typedef struct {
+   int quod;
+   double tempus, c;
+   PVI_CORPUS *argumentum, *F, *Z, *B;
+} pvi_petitio;
+
+/* Block forms of the field: campus writes F[n] = f(n, t, X) and gradus
+   performs X[n] += c * punctum_X(n, Y) (or the same with X and Y
+   exchanged), both for a <= n < b. */
+typedef void (*pvi_campus)(size_t a, size_t b, double t,
+   PVI_CORPUS *X, PVI_CORPUS *F, void *data);
+typedef void (*pvi_gradus)(size_t a, size_t b, double c,
+   PVI_CORPUS *X, PVI_CORPUS *Y, void *data);
+
+typedef struct pvi_contextus pvi_contextus;
+struct pvi_contextus {
+   int methodus; /* fixed by pvi_crea */
+   size_t dimensio; /* fixed by pvi_crea */
+   double tempus, h;
+   PVI_CORPUS *x, *y;
+   PVI_CORPUS (*punctum)(size_t n, double t, PVI_CORPUS *X, void *data);
+   pvi_campus campus;
+   PVI_CORPUS (*punctum_X)(size_t n, PVI_CORPUS *Y, void *data);
+   PVI_CORPUS (*punctum_Y)(size_t n, PVI_CORPUS *X, void *data);
+   pvi_gradus gradus_X, gradus_Y;
+   void *data;
+   size_t blocus;
+   double tolerantia_absoluta, tolerantia_relativa; /* default 1e-6 */
+   double terminus; /* the steps of variable size do not go beyond it */
+   int fusus; /* symplectic methods: one wavefront sweep per step */
+   int symmetria; /* PVI_KRYLOV: D symmetric (1), antisymmetric (-1) */
+   int densus; /* keep the next step for pvi_interpola */
+   unsigned long acceptati, rejecti, evaluationes;
+   /* private to the implementation */
+   int status, ordo, quod[PVI_STADIA_MAXIMA];
+   double coefficiens[PVI_STADIA_MAXIMA];
+   PVI_CORPUS *spatium[6];
+   pvi_arena arena;
+   /* PVI_ABM_VARIABILIS: historia[j] is the field at tempora[j], the
+      newest first, for j < historiae, and historia[PVI_ORDO_MAXIMUS + 1]
+      receives the next evaluation; PVI_DOPRI5: historia[0] to historia[6]
+      are the stages, and historiae is 1 while the first one is valid */
+   int ordo_adams, historiae, rejectus, defectus;
+   double passus, errores[3], erratum_prius, tempora[PVI_ORDO_MAXIMUS + 2];
+   PVI_CORPUS *historia[PVI_ORDO_MAXIMUS + 2];
+   /* PVI_KRYLOV: the basis is in the arena, the Hessenberg matrix (rows of
+      PVI_KRYLOV_MAXIMUS) and the partial sums of pvi__producta in
+      hessenberg; the last step used subspatium vectors and |x| = norma at
+      its start, and errores[0] bounds the norm of the matrix */
+   int subspatium;
+   double norma, *hessenberg;
+   /* dense output: the state at tempus_prius and, for the symplectic
+      methods, the derivatives at both ends of the step (see pvi__serva),
+      each array after limbus zeros and followed by as many */
+   pvi_arena densa;
+   double tempus_prius;
+   int servatum;
+   size_t limbus;
+};
+
+/* Number of indices handed over at once to the block callbacks by the
+   parallel sweeps. */
+#ifndef PVI_FRUSTUM
+#define PVI_FRUSTUM ((size_t)4096)
+#endif
+
+#define PVI_RAIZ_CUBICA_2 1.2599210498948731647672106
+
+PVI_FUNCTIO void pvi_destrue(pvi_contextus *pvi_c){
+   if(pvi_c == NULL) return;
+   pvi_arena_libera(&pvi_c->arena);
+   pvi_arena_libera(&pvi_c->densa);
+   free(pvi_c->hessenberg);
+   free(pvi_c);
+}
+
+/* Returns NULL if there is not enough memory for the method. */
+PVI_FUNCTIO pvi_contextus *pvi_crea(int methodus, size_t dimensio, double h){
+   pvi_contextus *pvi_c;
+   int k, spatia;
+
+   pvi_c = (pvi_contextus*)calloc((size_t)1, sizeof(*pvi_c));
+   if(pvi_c == NULL) return NULL;
+   pvi_c->methodus = methodus;
+   pvi_c->dimensio = dimensio;
+   pvi_c->h = h;
+   pvi_c->blocus = (size_t)64;
+   pvi_c->tolerantia_absoluta = pvi_c->tolerantia_relativa = 1e-6;
+   pvi_c->terminus = HUGE_VAL;
+   pvi_c->erratum_prius = 1e-4;
+
+   spatia = (methodus == PVI_EULER ? 1 :
+      methodus == PVI_RK2 ? 3 : methodus == PVI_RK4 ? 6 :
+      methodus == PVI_DOPRI5 ? 8 :
+      methodus == PVI_ABM_VARIABILIS ? PVI_ORDO_MAXIMUS + 3 :
+      methodus == PVI_KRYLOV ? PVI_KRYLOV_MAXIMUS + 1 : 0);
+   if(pvi_arena_para(&pvi_c->arena, (size_t)spatia, dimensio) != 0){
+      pvi_destrue(pvi_c);
+      return NULL;
+   }
+   if(methodus == PVI_KRYLOV){
+      pvi_c->hessenberg = (double*)calloc(
+         (size_t)(PVI_KRYLOV_MAXIMUS + 1) * (size_t)PVI_KRYLOV_MAXIMUS +
+         (size_t)(PVI_KRYLOV_MAXIMUS + 1) *
+         ((dimensio + PVI_FRUSTUM - 1) / PVI_FRUSTUM),
+         sizeof(double));
+      if(pvi_c->hessenberg == NULL){
+         pvi_destrue(pvi_c);
+         return NULL;
+      }
+      /* the basis is taken straight from the arena */
+      return pvi_c;
+   }
+   if(methodus == PVI_DOPRI5 || methodus == PVI_ABM_VARIABILIS){
+      pvi_c->spatium[0] = pvi_arena_pars(&pvi_c->arena, (size_t)0);
+      for(k = 1; k < spatia; ++k)
+         pvi_c->historia[k - 1] = pvi_arena_pars(&pvi_c->arena, (size_t)k);
+      return pvi_c;
+   }
+   for(k = 0; k < spatia; ++k)
+      pvi_c->spatium[k] = pvi_arena_pars(&pvi_c->arena, (size_t)k);
+   return pvi_c;
+}
+
+/* Forgets the history of PVI_DOPRI5 and PVI_ABM_VARIABILIS, which must be
+   done when x or tempus are changed between two steps. */
+PVI_FUNCTIO void pvi_obliviscere(pvi_contextus *pvi_c){
+   pvi_c->historiae = 0;
+   pvi_c->status = 0;
+   pvi_c->defectus = 0;
+   pvi_c->rejectus = 0;
+   pvi_c->erratum_prius = 1e-4;
+}
+
+/* Coefficients of the symplectic methods, as fractions of the step, in
+   the order in which the sub-stages are performed. The sub-stages alternate
+   between X and Y, starting with the one in pvi__compositio.primus. Ruth3
+   and the methods of order 2 are given in closed form. The other tables
+   were computed in multiple precision and checked against the order
+   conditions, so they hold every digit a double can carry. Most are
+   symmetric, so the last sub-stage of a step may be merged with the first
+   one of the next step whenever the state between steps is not needed.
+   * PVI_YOSHIDA6 and PVI_YOSHIDA8: Yoshida's compositions of Verlet of
+     orders 6 (solution A, 7 Verlet steps) and 8 (solution D, 15 steps),
+     Phys. Lett. A 150 (1990) 262;
+   * PVI_BLANES_MOAN4 and PVI_BLANES_MOAN6: the optimised partitioned
+     Runge-Kutta methods of orders 4 (S6) and 6 (S10) of Blanes and Moan,
+     J. Comput. Appl. Math. 142 (2002) 313;
+   * PVI_BLANES_MOAN_RKN4 and PVI_BLANES_MOAN_RKN6: the Runge-Kutta-Nystrom
+     methods SRKN6 (order 4) and SRKN11 (order 6) of the same paper. They
+     begin with Y and their order only holds when X_punctum(n, Y) is
+     linear in Y, as for a kinetic energy quadratic in the momenta;
+   * PVI_SABAn and PVI_SBABn: the methods of Laskar and Robutel, Celest.
+     Mech. Dyn. Astron. 80 (2001) 39, for H = A(Y) + e B(X). Their error
+     is of order h^2n e + h^2 e^2, they are meant for small perturbations
+     of an integrable system. */
+typedef struct {
+   int primus, stadia;
+   const double *c;
+} pvi__compositio;
+
+static PVI__INUTILIS const double pvi__euler_s[2] = { 1.0, 1.0 };
+static PVI__INUTILIS const double pvi__verlet[3] = { 0.5, 1.0, 0.5 };
+static PVI__INUTILIS const double pvi__ruth3[6] = {
+   7.0 / 24.0, 2.0 / 3.0, 0.75, -2.0 / 3.0, -1.0 / 24.0, 1.0
+};
+/* Forest and Ruth, the triple jump of Verlet with the weights
+   1 / (2 - 2^(1/3)), -2^(1/3) / (2 - 2^(1/3)) and 1 / (2 - 2^(1/3)) */
+static PVI__INUTILIS const double pvi__ruth4[7] = {
+   0.6756035959798288170238, 1.351207191959657634048,
+   -0.1756035959798288170238, -1.702414383919315268095,
+   -0.1756035959798288170238, 1.351207191959657634048,
+   0.6756035959798288170238
+};
+
+static PVI__INUTILIS const double pvi__yoshida6[15] = {
+   0.3922568052387786496915, 0.7845136104775572993830,
+   0.5100434119184577147488, 0.2355732133593581301145,
+   -0.4710533854097564282482, -1.177679984178870986611,
+   0.06875316825252006380786, 1.315186320683911114227,
+   0.06875316825252006380786, -1.177679984178870986611,
+   -0.4710533854097564282482, 0.2355732133593581301145,
+   0.5100434119184577147488, 0.7845136104775572993830,
+   0.3922568052387786496915
+};
+
+static PVI__INUTILIS const double pvi__yoshida8[31] = {
+   0.4574221231148957733659, 0.9148442462297915467317,
+   0.5842687913980014469129, 0.2536933365662113470940,
+   -0.5955794501471969037976, -1.444852236860605154689,
+   -0.8015464361143276594834, -0.1582406353680501642778,
+   0.8899492511272378558740, 1.938139137622525876026,
+   -0.01123554767639245444144, -1.960610232975310784909,
+   -0.9289051917917571718486, 0.1027998493917964412114,
+   0.9056264600895391134183, 1.708453070787281785625,
+   0.9056264600895391134183, 0.1027998493917964412114,
+   -0.9289051917917571718486, -1.960610232975310784909,
+   -0.01123554767639245444144, 1.938139137622525876026,
+   0.8899492511272378558740, -0.1582406353680501642778,
+   -0.8015464361143276594834, -1.444852236860605154689,
+   -0.5955794501471969037976, 0.2536933365662113470940,
+   0.5842687913980014469129, 0.9148442462297915467317,
+   0.4574221231148957733659
+};
+
+static PVI__INUTILIS const double pvi__blanes_moan4[13] = {
+   0.07920369643119566649414, 0.2095151066133620343379,
+   0.3531729060497739713931, -0.1438517731798180099290,
+   -0.04206508035771953230020, 0.4343366665664559755911,
+   0.2193769557534997888260, 0.4343366665664559755911,
+   -0.04206508035771953230020, -0.1438517731798180099290,
+   0.3531729060497739713931, 0.2095151066133620343379,
+   0.07920369643119566649414
+};
+
+static PVI__INUTILIS const double pvi__blanes_moan6[21] = {
+   0.05026276440039268572635, 0.1488164479010432306172,
+   0.4135143004283438061819, -0.1323858657677836336841,
+   0.04507988979439806614957, 0.06730760469218445563033,
+   -0.1880548538195689067809, 0.4326664025781735700704,
+   0.541960678450780108939, -0.01640458940361762263382,
+   -0.7255255585086915204318, -0.01640458940361762263382,
+   0.541960678450780108939, 0.4326664025781735700704,
+   -0.1880548538195689067809, 0.06730760469218445563033,
+   0.04507988979439806614957, -0.1323858657677836336841,
+   0.4135143004283438061819, 0.1488164479010432306172,
+   0.05026276440039268572635
+};
+
+static PVI__INUTILIS const double pvi__blanes_moan_rkn4[13] = {
+   0.08298440641740502388135, 0.2452989571842711657990,
+   0.3963098014983680861256, 0.6048726657110800042361,
+   -0.03905630492234843376131, -0.3501716228953511700350,
+   0.1195241940131506475087, -0.3501716228953511700350,
+   -0.03905630492234843376131, 0.6048726657110800042361,
+   0.3963098014983680861256, 0.2452989571842711657990,
+   0.08298440641740502388135
+};
+
+static PVI__INUTILIS const double pvi__blanes_moan_rkn6[23] = {
+   0.04146499851826284527290, 0.1232297759462711583822,
+   0.1981286719180665456541, 0.2905537977995582554769,
+   -0.04000619210415268939274, -0.1270492126254169074073,
+   0.07525398430158034002169, -0.2463317610620754105621,
+   -0.01151138742068777073846, 0.3572088727959277787427,
+   0.2366699247869307291825, 0.2047770542914702507353,
+   0.2366699247869307291825, 0.3572088727959277787427,
+   -0.01151138742068777073846, -0.2463317610620754105621,
+   0.07525398430158034002169, -0.1270492126254169074073,
+   -0.04000619210415268939274, 0.2905537977995582554769,
+   0.1981286719180665456541, 0.1232297759462711583822,
+   0.04146499851826284527290
+};
+
+/* 1/2 - sqrt(3)/6, 1/2, sqrt(3)/3 */
+static PVI__INUTILIS const double pvi__saba2[5] = {
+   0.2113248654051871177454, 0.5, 0.5773502691896257645091, 0.5,
+   0.2113248654051871177454
+};
+/* 1/2 - sqrt(15)/10, 5/18, sqrt(15)/10, 4/9 */
+static PVI__INUTILIS const double pvi__saba3[7] = {
+   0.1127016653792583114821, 5.0 / 18.0, 0.3872983346207416885179,
+   4.0 / 9.0, 0.3872983346207416885179, 5.0 / 18.0,
+   0.1127016653792583114821
+};
+/* the nodes and weights of the Gauss-Legendre rule of 4 points */
+static PVI__INUTILIS const double pvi__saba4[9] = {
+   0.06943184420297371238803, 0.1739274225687269286865,
+   0.2605776340045981552106, 0.3260725774312730713135,
+   0.3399810435848562648027, 0.3260725774312730713135,
+   0.2605776340045981552106, 0.1739274225687269286865,
+   0.06943184420297371238803
+};
+static PVI__INUTILIS const double pvi__sbab2[5] = {
+   1.0 / 6.0, 0.5, 2.0 / 3.0, 0.5, 1.0 / 6.0
+};
+/* 1/12, 1/2 - sqrt(5)/10, 5/12, sqrt(5)/5 */
+static PVI__INUTILIS const double pvi__sbab3[7] = {
+   1.0 / 12.0, 0.2763932022500210303591, 5.0 / 12.0,
+   0.4472135954999579392818, 5.0 / 12.0, 0.2763932022500210303591,
+   1.0 / 12.0
+};
+/* 1/20, 1/2 - sqrt(21)/14, 49/180, sqrt(21)/14, 16/45 */
+static PVI__INUTILIS const double pvi__sbab4[9] = {
+   1.0 / 20.0, 0.1726731646460114281009, 49.0 / 180.0,
+   0.3273268353539885718991, 16.0 / 45.0, 0.3273268353539885718991,
+   49.0 / 180.0, 0.1726731646460114281009, 1.0 / 20.0
+};
+
+#define PVI__COMPOSITIO(primus, c) { primus, (int)(sizeof(c) / sizeof(*(c))), c }
+static PVI__INUTILIS const pvi__compositio pvi__compositiones[] = {
+   PVI__COMPOSITIO(PVI_GRADUS_X, pvi__euler_s),
+   PVI__COMPOSITIO(PVI_GRADUS_X, pvi__verlet),
+   PVI__COMPOSITIO(PVI_GRADUS_Y, pvi__ruth3),
+   PVI__COMPOSITIO(PVI_GRADUS_X, pvi__ruth4),
+   PVI__COMPOSITIO(PVI_GRADUS_X, pvi__ruth4), /* PVI_RUTH4_FUSUS */
+   PVI__COMPOSITIO(PVI_GRADUS_X, pvi__yoshida6),
+   PVI__COMPOSITIO(PVI_GRADUS_X, pvi__yoshida8),
+   PVI__COMPOSITIO(PVI_GRADUS_X, pvi__blanes_moan4),
+   PVI__COMPOSITIO(PVI_GRADUS_X, pvi__blanes_moan6),
+   PVI__COMPOSITIO(PVI_GRADUS_Y, pvi__blanes_moan_rkn4),
+   PVI__COMPOSITIO(PVI_GRADUS_Y, pvi__blanes_moan_rkn6),
+   PVI__COMPOSITIO(PVI_GRADUS_X, pvi__saba2),
+   PVI__COMPOSITIO(PVI_GRADUS_X, pvi__saba3),
+   PVI__COMPOSITIO(PVI_GRADUS_X, pvi__saba4),
+   PVI__COMPOSITIO(PVI_GRADUS_Y, pvi__sbab2),
+   PVI__COMPOSITIO(PVI_GRADUS_Y, pvi__sbab3),
+   PVI__COMPOSITIO(PVI_GRADUS_Y, pvi__sbab4)
+};
+#undef PVI__COMPOSITIO
+
+/* Names accepted by pvi_methodus, in the order of the enumeration. */
+static PVI__INUTILIS const char *const pvi__nomina[PVI__METHODI] = {
+   "euler", "rk2", "rk4", "dopri5", "abm", "krylov",
+   "euler_s", "verlet", "ruth3", "ruth4", "ruth4_fusus",
+   "yoshida6", "yoshida8", "blanes_moan4", "blanes_moan6",
+   "blanes_moan_rkn4", "blanes_moan_rkn6",
+   "saba2", "saba3", "saba4", "sbab2", "sbab3", "sbab4"
+};
+
+/* Returns the method called `nomen` (see pvi__nomina), or -1. */
+PVI_FUNCTIO int pvi_methodus(const char *nomen){
+   int k;
+   for(k = 0; k < PVI__METHODI; ++k)
+      if(strcmp(nomen, pvi__nomina[k]) == 0) return k;
+   return -1;
+}
+
+/* The name of `methodus` for pvi_methodus, or NULL past the last one. */
+PVI_FUNCTIO const char *pvi_nomen(int methodus){
+   if(methodus < 0 || methodus >= PVI__METHODI) return NULL;
+   return pvi__nomina[methodus];
+}
+
+/* Sub-stages of one step of the symplectic method, the coefficients of
+   the table multiplied by h. */
+PVI_FUNCTIO void pvi__ordo(pvi_contextus *pvi_c){
+   const pvi__compositio *m =
+      &pvi__compositiones[pvi_c->methodus - PVI_EULER_S];
+   int k;
+
+   pvi_c->ordo = m->stadia;
+   for(k = 0; k < m->stadia; ++k){
+      pvi_c->coefficiens[k] = pvi_c->h * m->c[k];
+      pvi_c->quod[k] = ((k % 2 == 0) == (m->primus == PVI_GRADUS_X) ?
+         PVI_GRADUS_X : PVI_GRADUS_Y);
+   }
+}
+
+/* Wavefront sweep over the indices, the sub-stage k acts on the block that
+   starts blocus * k indices behind the front and only inside
+   [lo[k], hi[k]). */
+PVI_INLINE void pvi__unda(pvi_contextus *pvi_c, const size_t *lo,
+   const size_t *hi, pvi_gradus gradus_X, pvi_gradus gradus_Y){
+   const size_t B = pvi_c->blocus;
+   const size_t S = (size_t)pvi_c->ordo;
+   size_t p, p1, k, a, b;
+
+   p = ~(size_t)0;
+   p1 = (size_t)0;
+   for(k = (size_t)0; k < S; ++k){
+      if(lo[k] + k * B < p) p = lo[k] + k * B;
+      if(hi[k] + k * B > p1) p1 = hi[k] + k * B;
+   }
+   for(; p < p1; p += B){
+      for(k = (size_t)0; k < S; ++k){
+         if(p < lo[k] + k * B) continue;
+         a = p - k * B;
+         b = a + B;
+         if(b > hi[k]) b = hi[k];
+         if(a >= b) continue;
+         if(pvi_c->quod[k] == PVI_GRADUS_X)
+            gradus_X(a, b, pvi_c->coefficiens[k], pvi_c->x, pvi_c->y, pvi_c->data);
+         else
+            gradus_Y(a, b, pvi_c->coefficiens[k], pvi_c->y, pvi_c->x, pvi_c->data);
+      }
+   }
+}
+
+/* One step of a symplectic method in a single wavefront sweep, only valid
+   when gradus_X(n) depends on Y[n] alone and gradus_Y(n) on X[n - blocus]
+   to X[n + blocus], as in a chain with nearest-neighbour coupling. Every
+   sub-stage sees its neighbours exactly as the separate sweeps would,
+   hence the trajectory is the same as without fusus. With OpenMP each
+   thread sweeps its own segment, leaving undone the sub-stages that need
+   indices of the neighbouring segments (a staircase of blocus indices per
+   sub-stage at each end), and after a barrier it finishes the valley
+   around the left end of its segment. Hence there are two synchronisations
+   per step instead of one per sub-stage. */
+PVI_INLINE void pvi__fusus_per(pvi_contextus *pvi_c,
+   pvi_gradus gradus_X, pvi_gradus gradus_Y){
+   const size_t N = pvi_c->dimensio, B = pvi_c->blocus;
+   const size_t S = (size_t)pvi_c->ordo;
+   size_t pvi_partes;
+
+   /* the valleys must not overlap, so each segment spans 2 S + 2 blocks
+      or more */
+   pvi_partes = PVI_PARTES_MAXIMAE();
+   if(N < PVI_PARALLELUS_MINIMUS) pvi_partes = (size_t)1;
+   if(pvi_partes > N / ((2 * S + 2) * B)) pvi_partes = N / ((2 * S + 2) * B);
+   if(pvi_partes < (size_t)1) pvi_partes = (size_t)1;
+   (void)pvi_partes;
+
+   PVI_PARALLELUS_REGIO
+   {
+      size_t lo[PVI_STADIA_MAXIMA], hi[PVI_STADIA_MAXIMA], s, e, j;
+      s = N * PVI_PARS() / PVI_PARTES();
+      e = N * (PVI_PARS() + (size_t)1) / PVI_PARTES();
+      for(j = (size_t)0; j < S; ++j){
+         lo[j] = s + (s > (size_t)0 ? j * B : (size_t)0);
+         hi[j] = e - (e < N ? j * B : (size_t)0);
+      }
+      pvi__unda(pvi_c, lo, hi, gradus_X, gradus_Y);
+      PVI_PARALLELUS_SYNCHRONIZA
+      if(s > (size_t)0){
+         for(j = (size_t)0; j < S; ++j){
+            lo[j] = s - j * B;
+            hi[j] = s + j * B;
+         }
+         pvi__unda(pvi_c, lo, hi, gradus_X, gradus_Y);
+      }
+   }
+}
+
+PVI_FUNCTIO void pvi__fusus(pvi_contextus *pvi_c){
+   pvi__fusus_per(pvi_c, pvi_c->gradus_X, pvi_c->gradus_Y);
+}
+
+/* Dormand-Prince 5(4): the row j of pvi__dopri5_a holds the coefficients of
+   the stage j + 1, the last row being the weights of the solution of order
+   5, and pvi__dopri5_e the difference to the weights of order 4. */
+static PVI__INUTILIS const double pvi__dopri5_c[7] = {
+   0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0
+};
+static PVI__INUTILIS const double pvi__dopri5_a[7][6] = {
+   { 0.0 },
+   { 1.0 / 5.0 },
+   { 3.0 / 40.0, 9.0 / 40.0 },
+   { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0 },
+   { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0 },
+   { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0,
+      -5103.0 / 18656.0 },
+   { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0,
+      11.0 / 84.0 }
+};
+static PVI__INUTILIS const double pvi__dopri5_e[7] = {
+   71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0,
+   22.0 / 525.0, -1.0 / 40.0
+};
+
+/* Asks the stage j of PVI_DOPRI5, from the stages 0 to j - 1. */
+PVI_FUNCTIO int pvi__dopri5_gradus(pvi_contextus *pvi_c, pvi_petitio *p, int j){
+   const size_t N = pvi_c->dimensio;
+   const double t = pvi_c->tempus;
+   PVI_CORPUS **K = pvi_c->historia, *X = pvi_c->x, *Z = pvi_c->spatium[0];
+   double a[6], hs;
+   size_t n;
+   int i;
+
+   if(j == 1){
+      hs = pvi_c->h;
+      if(t + hs > pvi_c->terminus) hs = pvi_c->terminus - t;
+      pvi_c->passus = hs;
+   }
+   hs = pvi_c->passus;
+   for(i = 0; i < j; ++i) a[i] = hs * pvi__dopri5_a[j][i];
+   /* one loop per stage, with the number of terms fixed, vectorizes */
+   switch(j){
+      case 1:
+         PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n)
+            Z[n] = X[n] + K[0][n] * a[0];
+         break;
+      case 2:
+         PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n)
+            Z[n] = X[n] + (K[0][n] * a[0] + K[1][n] * a[1]);
+         break;
+      case 3:
+         PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n)
+            Z[n] = X[n] + (K[0][n] * a[0] + K[1][n] * a[1] + K[2][n] * a[2]);
+         break;
+      case 4:
+         PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n){
+            Z[n] = X[n] + (K[0][n] * a[0] + K[1][n] * a[1] +
+               K[2][n] * a[2] + K[3][n] * a[3]);
+         }
+         break;
+      case 5:
+         PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n){
+            Z[n] = X[n] + (K[0][n] * a[0] + K[1][n] * a[1] +
+               K[2][n] * a[2] + K[3][n] * a[3] + K[4][n] * a[4]);
+         }
+         break;
+      default:
+         /* the solution of order 5, a[1] is zero */
+         PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n){
+            Z[n] = X[n] + (K[0][n] * a[0] + K[2][n] * a[2] +
+               K[3][n] * a[3] + K[4][n] * a[4] + K[5][n] * a[5]);
+         }
+         break;
+   }
+   p->F = K[j];
+   p->argumentum = Z;
+   p->tempus = t + hs * pvi__dopri5_c[j];
+   pvi_c->status = j + 1;
+   return 1;
+}
+
+/* Dormand-Prince 5(4) with local extrapolation, the last stage of a step
+   being the first of the next one (FSAL), and a PI controller of the step
+   as in DOPRI5 of Hairer and Wanner (beta = 0.04). The status tells which
+   stage has just been evaluated. */
+PVI_FUNCTIO int pvi__dopri5(pvi_contextus *pvi_c, pvi_petitio *p, int s){
+   const size_t N = pvi_c->dimensio;
+   const double t = pvi_c->tempus, hs = pvi_c->passus;
+   const double atol = pvi_c->tolerantia_absoluta;
+   const double rtol = pvi_c->tolerantia_relativa;
+   PVI_CORPUS **K = pvi_c->historia, *X = pvi_c->x, *Z = pvi_c->spatium[0];
+   PVI_CORPUS *k7;
+   double e[7], erratum = 0.0, f;
+   size_t n;
+   int j;
+
+   if(s == 0 && pvi_c->historiae == 0){
+      p->F = K[0];
+      pvi_c->status = 1;
+      return 1;
+   }
+   if(s <= 1){
+      pvi_c->historiae = 1;
+      return pvi__dopri5_gradus(pvi_c, p, 1);
+   }
+   if(s < 7) return pvi__dopri5_gradus(pvi_c, p, s);
+
+   for(j = 0; j < 7; ++j) e[j] = hs * pvi__dopri5_e[j];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(N >= PVI_PARALLELUS_MINIMUS) \
+   reduction(max: erratum)
+#endif
+   for(n = (size_t)0; n < N; ++n){
+      PVI_CORPUS d = 0.0, z;
+      int m;
+      for(m = 0; m < 7; ++m) d += K[m][n] * e[m];
+      z = atol + rtol *
+         (PVI__ABS(X[n]) > PVI__ABS(Z[n]) ? PVI__ABS(X[n]) : PVI__ABS(Z[n]));
+      if(!(PVI__ABS(d) <= erratum * z))
+         erratum = (d == d ? PVI__ABS(d) / z : HUGE_VAL);
+   }
+   if(!(erratum <= 1.0)){
+      f = 0.9 * pow(erratum, -0.2);
+      pvi_c->h = hs * (f < 0.2 ? 0.2 : f);
+      pvi_c->rejectus = 1;
+      ++pvi_c->rejecti;
+      if(!(t + pvi_c->h > t)){
+         pvi_c->defectus = 1;
+         pvi_c->status = 0;
+         return 0;
+      }
+      return pvi__dopri5_gradus(pvi_c, p, 1);
+   }
+
+   PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n) X[n] = Z[n];
+   k7 = K[6];
+   K[6] = K[0];
+   K[0] = k7;
+   pvi_c->tempus = (t + hs >= pvi_c->terminus ? pvi_c->terminus : t + hs);
+
+   f = (erratum > 0.0 ?
+      0.9 * pow(erratum, -0.17) * pow(pvi_c->erratum_prius, 0.04) : 10.0);
+   if(f < 0.2) f = 0.2;
+   if(f > (pvi_c->rejectus ? 1.0 : 10.0)) f = (pvi_c->rejectus ? 1.0 : 10.0);
+   pvi_c->h = hs * f;
+   pvi_c->erratum_prius = (erratum > 1e-4 ? erratum : 1e-4);
+   pvi_c->rejectus = 0;
+   pvi_c->status = 0;
+   return 0;
+}
+
+/* Gauss-Legendre rule with 7 nodes on [-1, 1], exact for polynomials up to
+   degree 13. */
+static PVI__INUTILIS const double pvi__gauss_x[7] = {
+   -0.9491079123427585245261897, -0.7415311855993944398638648,
+   -0.4058451513773971669066064, 0.0,
+   0.4058451513773971669066064, 0.7415311855993944398638648,
+   0.9491079123427585245261897
+};
+static PVI__INUTILIS const double pvi__gauss_w[7] = {
+   0.1294849661688696932706114, 0.2797053914892766679014678,
+   0.3818300505051189449503698, 0.4179591836734693877551020,
+   0.3818300505051189449503698, 0.2797053914892766679014678,
+   0.1294849661688696932706114
+};
+
+/* Weights of the Adams formulas for arbitrary nodes: w[j] is the integral
+   over [0, 1] of the Lagrange polynomial that is 1 at u[j] and 0 at the
+   other m - 1 nodes, the times being measured from the start of the step in
+   units of the step. */
+PVI_FUNCTIO void pvi__pondera(const double *u, int m, double *w){
+   double x, L;
+   int i, j, q;
+
+   for(j = 0; j < m; ++j){
+      w[j] = 0.0;
+      for(q = 0; q < 7; ++q){
+         x = 0.5 * (1.0 + pvi__gauss_x[q]);
+         L = 0.5 * pvi__gauss_w[q];
+         for(i = 0; i < m; ++i)
+            if(i != j) L *= (x - u[i]) / (u[j] - u[i]);
+         w[j] += L;
+      }
+   }
+}
+
+/* Factor of the next step for an error estimate e of the formula of
+   order m. */
+PVI_FUNCTIO double pvi__factor(double e, int m){
+   double f = (e > 0.0 ? 0.9 * pow(e, -1.0 / (double)(m + 1)) : 2.0);
+   return (f < 0.2 ? 0.2 : f > 2.0 ? 2.0 : f);
+}
+
+/* Predictor of PVI_ABM_VARIABILIS: the Adams-Bashforth formula through the
+   last ordo_adams slopes, after which the field is asked at the predicted
+   point. */
+PVI_FUNCTIO int pvi__adams_praedic(pvi_contextus *pvi_c, pvi_petitio *p){
+   const size_t N = pvi_c->dimensio;
+   const int k = pvi_c->ordo_adams;
+   const double t = pvi_c->tempus;
+   PVI_CORPUS **F = pvi_c->historia, *X = pvi_c->x, *Z = pvi_c->spatium[0];
+   double u[PVI_ORDO_MAXIMUS + 1] = { 0.0 }, b[PVI_ORDO_MAXIMUS + 1], hs;
+   size_t n;
+   int j;
+
+   hs = pvi_c->h;
+   if(t + hs > pvi_c->terminus) hs = pvi_c->terminus - t;
+   pvi_c->passus = hs;
+   for(j = 0; j < k; ++j) u[j] = (pvi_c->tempora[j] - t) / hs;
+   pvi__pondera(u, k, b);
+   for(j = 0; j < k; ++j) b[j] *= hs;
+   PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n){
+      PVI_CORPUS soma = 0.0;
+      int i;
+      for(i = k - 1; i >= 0; --i) soma += F[i][n] * b[i];
+      Z[n] = X[n] + soma;
+   }
+   p->F = F[PVI_ORDO_MAXIMUS + 1];
+   p->argumentum = Z;
+   p->tempus = t + hs;
+   pvi_c->status = 2;
+   return 1;
+}
+
+/* Variable step, variable order Adams-Bashforth-Moulton in PECE form. With
+   the slopes at the last k points the predictor is of order k and the
+   corrector, which also uses the slope at the predicted point, of order
+   k + 1; their difference estimates the error of the order k, which is the
+   one controlled, while the solution carries on with the corrector (local
+   extrapolation). The same difference is formed for the orders k - 1 and
+   k + 1, and after each step the order whose estimate allows the longest
+   next step is chosen, the lowest one in a tie. The history is a ring of
+   pointers, so that accepting a step moves no array. The maximum norm keeps
+   the estimate independent of the number of threads. */
+PVI_FUNCTIO int pvi__adams(pvi_contextus *pvi_c, pvi_petitio *p, int s){
+   const size_t N = pvi_c->dimensio;
+   const int M = PVI_ORDO_MAXIMUS + 1, k = pvi_c->ordo_adams;
+   const double t = pvi_c->tempus, hs = pvi_c->passus;
+   const double atol = pvi_c->tolerantia_absoluta;
+   const double rtol = pvi_c->tolerantia_relativa;
+   PVI_CORPUS **F = pvi_c->historia, *X = pvi_c->x, *Z = pvi_c->spatium[0];
+   double u[PVI_ORDO_MAXIMUS + 2], b[PVI_ORDO_MAXIMUS + 2];
+   double g[PVI_ORDO_MAXIMUS + 3], c[PVI_ORDO_MAXIMUS + 2];
+   double d[3][PVI_ORDO_MAXIMUS + 3], e0 = 0.0, e1 = 0.0, e2 = 0.0, f;
+   PVI_CORPUS *nova;
+   size_t n;
+   int J, j, m, q;
+
+   switch(s){
+      case 0:
+         if(pvi_c->historiae > 0) return pvi__adams_praedic(pvi_c, p);
+         pvi_c->tempora[0] = t;
+         p->F = F[0];
+         pvi_c->status = 1;
+         return 1;
+      case 1:
+         pvi_c->historiae = 1;
+         pvi_c->ordo_adams = 1;
+         pvi_c->rejectus = 0;
+         return pvi__adams_praedic(pvi_c, p);
+      case 2:
+         /* the estimates of the orders k - 1, k and k + 1, when the history
+            allows, as coefficients of the slopes at t + hs, tempora[0], ... */
+         J = (k < PVI_ORDO_MAXIMUS && pvi_c->historiae > k ? k + 1 : k);
+         u[0] = 1.0;
+         for(j = 0; j < J; ++j) u[j + 1] = (pvi_c->tempora[j] - t) / hs;
+         for(q = 0; q < 3; ++q){
+            for(j = 0; j <= J; ++j) d[q][j] = 0.0;
+            m = k - 1 + q;
+            if(m < 1 || m > J) continue;
+            pvi__pondera(u, m + 1, g);
+            pvi__pondera(u + 1, m, b);
+            for(j = 0; j <= m; ++j) d[q][j] = hs * (g[j] - (j > 0 ? b[j - 1] : 0.0));
+            if(q == 1) for(j = 0; j <= m; ++j) c[j] = hs * g[j];
+         }
+         /* the corrector goes to Z, and X is kept in case of rejection */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(N >= PVI_PARALLELUS_MINIMUS) \
+   reduction(max: e0, e1, e2)
+#endif
+         for(n = (size_t)0; n < N; ++n){
+            PVI_CORPUS x, y, s0, s1, s2, z;
+            int i;
+            x = F[M][n];
+            y = c[0] * x;
+            s0 = d[0][0] * x;
+            s1 = d[1][0] * x;
+            s2 = d[2][0] * x;
+            for(i = 0; i < J; ++i){
+               x = F[i][n];
+               if(i < k) y += c[i + 1] * x;
+               s0 += d[0][i + 1] * x;
+               s1 += d[1][i + 1] * x;
+               s2 += d[2][i + 1] * x;
+            }
+            y += X[n];
+            z = atol + rtol *
+               (PVI__ABS(X[n]) > PVI__ABS(y) ? PVI__ABS(X[n]) : PVI__ABS(y));
+            if(!(PVI__ABS(s0) <= e0 * z))
+               e0 = (s0 == s0 ? PVI__ABS(s0) / z : HUGE_VAL);
+            if(!(PVI__ABS(s1) <= e1 * z))
+               e1 = (s1 == s1 ? PVI__ABS(s1) / z : HUGE_VAL);
+            if(!(PVI__ABS(s2) <= e2 * z))
+               e2 = (s2 == s2 ? PVI__ABS(s2) / z : HUGE_VAL);
+            Z[n] = y;
+         }
+         pvi_c->errores[0] = (k > 1 ? e0 : -1.0);
+         pvi_c->errores[1] = e1;
+         pvi_c->errores[2] = (J > k ? e2 : -1.0);
+         if(!(e1 <= 1.0)){
+            pvi_c->h = hs * pvi__factor(e1, k);
+            if(k > 1 && e0 < e1) --pvi_c->ordo_adams;
+            pvi_c->rejectus = 1;
+            ++pvi_c->rejecti;
+            if(!(t + pvi_c->h > t)){
+               pvi_c->defectus = 1;
+               pvi_c->status = 0;
+               return 0;
+            }
+            return pvi__adams_praedic(pvi_c, p);
+         }
+         PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n) X[n] = Z[n];
+         p->F = F[M];
+         p->tempus = t + hs;
+         pvi_c->status = 3;
+         return 1;
+   }
+   /* the new slope enters the ring and the oldest one becomes the spare */
+   nova = F[M];
+   for(j = M; j > 0; --j){
+      F[j] = F[j - 1];
+      pvi_c->tempora[j] = pvi_c->tempora[j - 1];
+   }
+   F[0] = nova;
+   pvi_c->tempus = (t + hs >= pvi_c->terminus ? pvi_c->terminus : t + hs);
+   pvi_c->tempora[0] = pvi_c->tempus;
+   if(pvi_c->historiae < M) ++pvi_c->historiae;
+
+   m = k;
+   f = pvi__factor(pvi_c->errores[1], k);
+   if(pvi_c->errores[0] >= 0.0 && pvi__factor(pvi_c->errores[0], k - 1) >= f){
+      m = k - 1;
+      f = pvi__factor(pvi_c->errores[0], k - 1);
+   }
+   if(pvi_c->errores[2] >= 0.0 && pvi__factor(pvi_c->errores[2], k + 1) > f){
+      m = k + 1;
+      f = pvi__factor(pvi_c->errores[2], k + 1);
+   }
+   /* no growth right after a rejection */
+   if(pvi_c->rejectus && f > 1.0) f = 1.0;
+   pvi_c->ordo_adams = m;
+   pvi_c->h = hs * f;
+   pvi_c->rejectus = 0;
+   pvi_c->status = 0;
+   return 0;
+}
+
+/* ------------------------------------
+   Exponencial de Krylov
+----------------------------------- */
+
+/* h[i] = sum_n V[i][n] w[n] for i < m. Each block of PVI_FRUSTUM indices
+   is summed apart and the blocks are added in order, so the sums do not
+   depend on the number of threads. */
+PVI_FUNCTIO void pvi__producta(pvi_contextus *pvi_c, PVI_CORPUS *const *V,
+   int m, const PVI_CORPUS *w, double *h){
+   const size_t N = pvi_c->dimensio, M = (size_t)PVI_KRYLOV_MAXIMUS + 1;
+   const size_t B = (N + PVI_FRUSTUM - 1) / PVI_FRUSTUM;
+   double *s = pvi_c->hessenberg + M * (M - 1);
+   size_t a;
+   int i;
+
+   PVI_PARALLELE_SI(N) for(a = (size_t)0; a < B; ++a){
+      const size_t n0 = a * PVI_FRUSTUM;
+      const size_t n1 = (N - n0 > PVI_FRUSTUM ? n0 + PVI_FRUSTUM : N);
+      size_t n;
+      int j;
+      for(j = 0; j < m; ++j){
+         double x = 0.0;
+         for(n = n0; n < n1; ++n) x += V[j][n] * w[n];
+         s[a * M + (size_t)j] = x;
+      }
+   }
+   for(i = 0; i < m; ++i){
+      h[i] = 0.0;
+      for(a = (size_t)0; a < B; ++a) h[i] += s[a * M + (size_t)i];
+   }
+}
+
+/* w[n] -= sum_i h[i] V[i][n] for i < m */
+PVI_FUNCTIO void pvi__subtrahe(size_t N, PVI_CORPUS *w,
+   PVI_CORPUS *const *V, const double *h, int m){
+   size_t n;
+
+   PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n){
+      PVI_CORPUS x = 0.0;
+      int i;
+      for(i = 0; i < m; ++i) x += V[i][n] * h[i];
+      w[n] -= x;
+   }
+}
+
+/* C = A B, all m x m with rows of m numbers */
+PVI_FUNCTIO void pvi__multiplica(int m, const double *A, const double *B,
+   double *C){
+   int i, j, k;
+
+   for(i = 0; i < m * m; ++i) C[i] = 0.0;
+   for(i = 0; i < m; ++i)
+      for(k = 0; k < m; ++k)
+         for(j = 0; j < m; ++j) C[i * m + j] += A[i * m + k] * B[k * m + j];
+}
+
+/* E = exp(tau H) for the upper left m x m block of H, whose rows hold
+   PVI_KRYLOV_MAXIMUS numbers, by the diagonal Pade approximant of degree 6
+   of tau H scaled to a norm below 1/2, squared back, as in EXPOKIT (Sidje,
+   ACM Trans. Math. Softw. 24 (1998) 130). The rows of E hold m numbers. */
+#define PVI__K2 (PVI_KRYLOV_MAXIMUS * PVI_KRYLOV_MAXIMUS)
+PVI_FUNCTIO void pvi__exponentialis(int m, const double *H, double tau,
+   double *E){
+   double X[PVI__K2], X2[PVI__K2], X4[PVI__K2], T[PVI__K2], U[PVI__K2];
+   double c[7], norma = 0.0, linea, x;
+   int i, j, k, q, potentia = 0;
+
+   if(m < 1 || m > PVI_KRYLOV_MAXIMUS) return;
+   for(i = 0; i < m; ++i){
+      for(j = 0, linea = 0.0; j < m; ++j)
+         linea += fabs(H[i * PVI_KRYLOV_MAXIMUS + j]);
+      if(linea > norma) norma = linea;
+   }
+   norma *= fabs(tau);
+   if(norma > 0.5){
+      (void)frexp(norma, &potentia);
+      ++potentia;
+   }
+   x = ldexp(tau, -potentia);
+   for(i = 0; i < m; ++i)
+      for(j = 0; j < m; ++j) X[i * m + j] = x * H[i * PVI_KRYLOV_MAXIMUS + j];
+
+   c[0] = 1.0;
+   for(k = 1; k < 7; ++k)
+      c[k] = c[k - 1] * (double)(7 - k) / (double)(k * (13 - k));
+   pvi__multiplica(m, X, X, X2);
+   pvi__multiplica(m, X2, X2, X4);
+   pvi__multiplica(m, X4, X2, T);
+   /* U = c0 + c2 X^2 + c4 X^4 + c6 X^6 and T = X (c1 + c3 X^2 + c5 X^4) */
+   for(i = 0; i < m * m; ++i){
+      U[i] = c[2] * X2[i] + c[4] * X4[i] + c[6] * T[i];
+      X4[i] = c[3] * X2[i] + c[5] * X4[i];
+   }
+   for(i = 0; i < m; ++i){
+      U[i * m + i] += c[0];
+      X4[i * m + i] += c[1];
+   }
+   pvi__multiplica(m, X, X4, T);
+   /* (U - T) E = U + T, by elimination with partial pivoting */
+   for(i = 0; i < m * m; ++i){
+      E[i] = U[i] + T[i];
+      U[i] -= T[i];
+   }
+   for(k = 0; k < m; ++k){
+      for(q = k, i = k + 1; i < m; ++i)
+         if(fabs(U[i * m + k]) > fabs(U[q * m + k])) q = i;
+      for(j = 0; q != k && j < m; ++j){
+         x = U[k * m + j];
+         U[k * m + j] = U[q * m + j];
+         U[q * m + j] = x;
+         x = E[k * m + j];
+         E[k * m + j] = E[q * m + j];
+         E[q * m + j] = x;
+      }
+      for(i = k + 1; i < m; ++i){
+         x = U[i * m + k] / U[k * m + k];
+         for(j = k; j < m; ++j) U[i * m + j] -= x * U[k * m + j];
+         for(j = 0; j < m; ++j) E[i * m + j] -= x * E[k * m + j];
+      }
+   }
+   for(k = m - 1; k >= 0; --k){
+      for(j = 0; j < m; ++j){
+         x = E[k * m + j];
+         for(i = k + 1; i < m; ++i) x -= U[k * m + i] * E[i * m + j];
+         E[k * m + j] = x / U[k * m + k];
+      }
+   }
+   for(; potentia > 0; --potentia){
+      pvi__multiplica(m, E, E, T);
+      memcpy(E, T, (size_t)(m * m) * sizeof(*E));
+   }
+}
+
+/* X = b sum_i E[i m] V[i] for i < m, with the first column of E */
+PVI_FUNCTIO void pvi__krylov_combina(size_t N, PVI_CORPUS *X, double b,
+   const double *E, PVI_CORPUS *const *V, int m){
+   size_t n;
+
+   PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n){
+      PVI_CORPUS x = 0.0;
+      int i;
+      for(i = 0; i < m; ++i) x += V[i][n] * E[i * m];
+      X[n] = x * b;
+   }
+}
+
+/* Krylov exponential. The status s > 0 tells that the field of the basis
+   vector s - 1 has just been written in the vector s, which is then made
+   orthogonal to the previous ones, giving the column s - 1 of the
+   Hessenberg matrix H. The error of exp(tau D) x ~ |x| V exp(tau H) e_1 is
+   estimated by |x| H[s][s - 1] |exp(tau H)[s - 1][0]|, the first term of
+   its expansion (Saad, SIAM J. Numer. Anal. 29 (1992) 209). */
+PVI_FUNCTIO int pvi__krylov(pvi_contextus *pvi_c, pvi_petitio *p, int s){
+   const size_t N = pvi_c->dimensio;
+   const int M = PVI_KRYLOV_MAXIMUS;
+   const double t = pvi_c->tempus;
+   double *H = pvi_c->hessenberg, h[PVI_KRYLOV_MAXIMUS + 1], E[PVI__K2];
+   double tau, b, seguinte, tolerantia, erratum, f, columna;
+   PVI_CORPUS *V[PVI_KRYLOV_MAXIMUS + 1], *X = pvi_c->x, *w;
+   size_t n;
+   int i, j, m, vez;
+
+   for(i = 0; i <= M; ++i) V[i] = pvi_arena_pars(&pvi_c->arena, (size_t)i);
+   if(s == 0){
+      tau = pvi_c->h;
+      if(t + tau > pvi_c->terminus) tau = pvi_c->terminus - t;
+      pvi_c->passus = tau;
+      pvi__producta(pvi_c, &X, 1, X, &b);
+      b = sqrt(b);
+      pvi_c->norma = b;
+      pvi_c->subspatium = 0;
+      pvi_c->errores[0] = 0.0;
+      if(b == 0.0){
+         pvi_c->tempus = (t + tau >= pvi_c->terminus ? pvi_c->terminus : t + tau);
+         pvi_c->status = 0;
+         return 0;
+      }
+      PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n) V[0][n] = X[n] / b;
+      p->F = V[1];
+      p->argumentum = V[0];
+      pvi_c->status = 1;
+      return 1;
+   }
+
+   j = s - 1;
+   m = s;
+   w = V[m];
+   for(i = 0; i < m; ++i) H[i * M + j] = 0.0;
+   if(pvi_c->symmetria != 0 && j > 0){
+      /* Lanczos: H[j - 1][j] = +-H[j][j - 1], and H[j][j] = 0 when D is
+         antisymmetric */
+      H[(j - 1) * M + j] = (pvi_c->symmetria > 0 ? 1.0 : -1.0) *
+         H[j * M + j - 1];
+      pvi__subtrahe(N, w, V + j - 1, &H[(j - 1) * M + j], 1);
+   }
+   if(pvi_c->symmetria > 0){
+      pvi__producta(pvi_c, V + j, 1, w, &H[j * M + j]);
+      pvi__subtrahe(N, w, V + j, &H[j * M + j], 1);
+   }else if(pvi_c->symmetria == 0){
+      /* Arnoldi by classical Gram-Schmidt, twice */
+      for(vez = 0; vez < 2; ++vez){
+         pvi__producta(pvi_c, V, m, w, h);
+         pvi__subtrahe(N, w, V, h, m);
+         for(i = 0; i < m; ++i) H[i * M + j] += h[i];
+      }
+   }
+   pvi__producta(pvi_c, &w, 1, w, &seguinte);
+   seguinte = sqrt(seguinte);
+   H[m * M + j] = seguinte;
+   for(i = 0, columna = seguinte; i < m; ++i) columna += fabs(H[i * M + j]);
+   if(columna > pvi_c->errores[0]) pvi_c->errores[0] = columna;
+
+   tau = pvi_c->passus;
+   b = pvi_c->norma;
+   tolerantia = pvi_c->tolerantia_absoluta * sqrt((double)N) +
+      pvi_c->tolerantia_relativa * b;
+   /* the subspace is invariant up to rounding, the step is exact */
+   if(!(seguinte > 1e-14 * pvi_c->errores[0])) seguinte = 0.0;
+   /* the exponential of H costs O(m^3), the error is only looked at for
+      every fourth vector */
+   erratum = HUGE_VAL;
+   if(m % 4 == 0 || m == M || seguinte == 0.0){
+      pvi__exponentialis(m, H, tau, E);
+      erratum = b * seguinte * fabs(E[(m - 1) * m]);
+   }
+   if(!(erratum <= tolerantia) && m < M){
+      PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n) w[n] /= seguinte;
+      p->F = V[m + 1];
+      p->argumentum = w;
+      pvi_c->status = m + 1;
+      return 1;
+   }
+   /* the largest subspace is not enough: the same basis serves any
+      shorter step, whose error falls roughly as tau^m */
+   while(!(erratum <= tolerantia)){
+      f = 0.9 * pow(tolerantia / erratum, 1.0 / (double)m);
+      tau *= (f >= 0.2 ? f : 0.2);
+      pvi_c->rejectus = 1;
+      ++pvi_c->rejecti;
+      if(!(t + tau > t)){
+         pvi_c->defectus = 1;
+         pvi_c->status = 0;
+         return 0;
+      }
+      pvi__exponentialis(m, H, tau, E);
+      erratum = b * seguinte * fabs(E[(m - 1) * m]);
+   }
+
+   pvi__krylov_combina(N, X, b, E, V, m);
+   pvi_c->subspatium = m;
+   pvi_c->passus = tau;
+   pvi_c->tempus = (t + tau >= pvi_c->terminus ? pvi_c->terminus : t + tau);
+   /* the error falls faster than any power of tau once m exceeds
+      |tau D|, so the larger the subspace the fewer the evaluations per
+      unit of time: the step doubles while the subspace has room */
+   pvi_c->h = (pvi_c->rejectus || 4 * m > 3 * M ? tau : 2.0 * tau);
+   pvi_c->rejectus = 0;
+   pvi_c->status = 0;
+   return 0;
+}
+
+PVI_FUNCTIO int pvi__pete(pvi_contextus *pvi_c, pvi_petitio *p){
+   const size_t N = pvi_c->dimensio;
+   const double h = pvi_c->h, t = pvi_c->tempus;
+   PVI_CORPUS **s = pvi_c->spatium, *X = pvi_c->x;
+   int k = pvi_c->status++;
+   size_t n;
+
+   p->quod = PVI_CAMPUS;
+   p->argumentum = X;
+   p->tempus = t;
+   p->B = X;
+   p->Z = NULL;
+   switch(pvi_c->methodus){
+      case PVI_EULER:
+         if(k == 0){
+            p->F = s[0];
+            return 1;
+         }
+         PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n)
+            X[n] += s[0][n] * h;
+         break;
+      case PVI_RK2:
+         switch(k){
+            case 0:
+               p->F = s[0];
+               p->Z = s[2];
+               p->c = h;
+               return 1;
+            case 1:
+               p->F = s[1];
+               p->argumentum = s[2];
+               p->tempus = t + h;
+               return 1;
+         }
+         PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n)
+            X[n] += (0.5 * h) * (s[0][n] + s[1][n]);
+         break;
+      case PVI_RK4:
+         switch(k){
+            case 0:
+               p->F = s[0];
+               p->Z = s[4];
+               p->c = 0.5 * h;
+               return 1;
+            case 1:
+               p->F = s[1];
+               p->argumentum = s[4];
+               p->tempus = t + 0.5 * h;
+               p->Z = s[5];
+               p->c = 0.5 * h;
+               return 1;
+            case 2:
+               p->F = s[2];
+               p->argumentum = s[5];
+               p->tempus = t + 0.5 * h;
+               p->Z = s[4];
+               p->c = h;
+               return 1;
+            case 3:
+               p->F = s[3];
+               p->argumentum = s[4];
+               p->tempus = t + h;
+               return 1;
+         }
+         PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n){
+            X[n] += (h / 6.0) * (
+               s[0][n] + s[3][n] + 2.0 * (s[1][n] + s[2][n])
+            );
+         }
+         break;
+      case PVI_DOPRI5:
+         return pvi__dopri5(pvi_c, p, k);
+      case PVI_ABM_VARIABILIS:
+         return pvi__adams(pvi_c, p, k);
+      case PVI_KRYLOV:
+         return pvi__krylov(pvi_c, p, k);
+      default:
+         if(pvi_c->fusus || pvi_c->methodus == PVI_RUTH4_FUSUS){
+            pvi__ordo(pvi_c);
+            pvi__fusus(pvi_c);
+            pvi_c->evaluationes += (unsigned long)pvi_c->ordo;
+            break;
+         }
+         if(k == 0) pvi__ordo(pvi_c);
+         if(k < pvi_c->ordo){
+            p->quod = pvi_c->quod[k];
+            p->c = pvi_c->coefficiens[k];
+            p->F = (p->quod == PVI_GRADUS_X ? pvi_c->x : pvi_c->y);
+            p->argumentum = (p->quod == PVI_GRADUS_X ? pvi_c->y : pvi_c->x);
+            return 1;
+         }
+         break;
+   }
+   pvi_c->status = 0;
+   pvi_c->tempus = t + h;
+   return 0;
+}
+
+/* Reverse communication interface, on which the macros are built: it
+   carries out the arithmetic of the method and, while the step is not
+   complete, returns 1 and fills `p` with the next evaluation of the field
+   that the caller must perform (see pvi_petitio). When the step is done it
+   returns 0, with tempus advanced by h (or by the step taken, for the
+   methods with step control). PVI_RUTH4_FUSUS, and the symplectic methods
+   with fusus set, call the block callbacks themselves and never ask for
+   anything. */
+PVI_FUNCTIO int pvi_pete(pvi_contextus *pvi_c, pvi_petitio *p){
+   if(pvi__pete(pvi_c, p)){
+      ++pvi_c->evaluationes;
+      return 1;
+   }
+   if(!pvi_c->defectus) ++pvi_c->acceptati;
+   return 0;
+}
+
+/* Performs the evaluation `p`, of kind PVI_CAMPUS, with the block form of
+   the field. */
+PVI_INLINE void pvi__exsequere_campus(pvi_contextus *pvi_c,
+   const pvi_petitio *p, pvi_campus campus){
+   const size_t N = pvi_c->dimensio;
+   size_t a;
+
+   PVI_PARALLELE_SI(N) for(a = (size_t)0; a < N; a += PVI_FRUSTUM){
+      const size_t b = (N - a > PVI_FRUSTUM ? a + PVI_FRUSTUM : N);
+      size_t m;
+      campus(a, b, p->tempus, p->argumentum, p->F, pvi_c->data);
+      if(p->Z == NULL) continue;
+      for(m = a; m < b; ++m) p->Z[m] = p->B[m] + p->F[m] * p->c;
+   }
+}
+
+/* Performs the evaluation `p`, of kind PVI_GRADUS_X or PVI_GRADUS_Y, with
+   the block forms of the field. */
+PVI_INLINE void pvi__exsequere_gradus(pvi_contextus *pvi_c,
+   const pvi_petitio *p, pvi_gradus gradus_X, pvi_gradus gradus_Y){
+   const size_t N = pvi_c->dimensio;
+   size_t a;
+
+   PVI_PARALLELE_SI(N) for(a = (size_t)0; a < N; a += PVI_FRUSTUM){
+      const size_t b = (N - a > PVI_FRUSTUM ? a + PVI_FRUSTUM : N);
+      if(p->quod == PVI_GRADUS_X)
+         gradus_X(a, b, p->c, p->F, p->argumentum, pvi_c->data);
+      else
+         gradus_Y(a, b, p->c, p->F, p->argumentum, pvi_c->data);
+   }
+}
+
+/* Performs the evaluation `p` with the callbacks of the context. */
+PVI_FUNCTIO void pvi__exsequere(pvi_contextus *pvi_c, const pvi_petitio *p){
+   const size_t N = pvi_c->dimensio;
+   size_t n;
+
+   if(p->quod == PVI_CAMPUS && pvi_c->campus != NULL){
+      pvi__exsequere_campus(pvi_c, p, pvi_c->campus);
+   }else if(p->quod == PVI_CAMPUS){
+      PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n){
+         p->F[n] = pvi_c->punctum(n, p->tempus, p->argumentum, pvi_c->data);
+         if(p->Z != NULL) p->Z[n] = p->B[n] + p->F[n] * p->c;
+      }
+   }else if(p->quod == PVI_GRADUS_X ? pvi_c->gradus_X != NULL : pvi_c->gradus_Y != NULL){
+      pvi__exsequere_gradus(pvi_c, p, pvi_c->gradus_X, pvi_c->gradus_Y);
+   }else{
+      PVI_CORPUS (*punctum)(size_t, PVI_CORPUS*, void*) =
+         (p->quod == PVI_GRADUS_X ? pvi_c->punctum_X : pvi_c->punctum_Y);
+      PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n)
+         p->F[n] += punctum(n, p->argumentum, pvi_c->data) * p->c;
+   }
+}
+
+/* The array k of the arena densa, past its leading zeros. */
+PVI_FUNCTIO PVI_CORPUS *pvi__densa(const pvi_contextus *pvi_c, size_t k){
+   return pvi_arena_pars(&pvi_c->densa, k) + pvi_c->limbus;
+}
+
+/* Keeps the start of the step for pvi_interpola. The arena densa holds
+   x (and y) at tempus_prius in the arrays 0 (and 1), and the output of
+   pvi_curre_densus in the last one or two; the symplectic methods also
+   keep there the derivatives of x and y at the start (2 and 3) and at the
+   end (4 and 5) of the step, evaluated only when servatum is 1 and
+   pvi_interpola asks for them. Those arrays are handed to gradus_X and
+   gradus_Y in place of x and y, whose stencil may reach blocus indices
+   past either end, so for the symplectic methods each one sits between
+   blocus zeros, as a chain at rest beyond its ends. */
+PVI_FUNCTIO void pvi__serva(pvi_contextus *pvi_c){
+   const size_t N = pvi_c->dimensio;
+   const int symplecticus = (pvi_c->methodus >= PVI_EULER_S);
+   const size_t L = (symplecticus ? pvi_c->blocus : (size_t)0);
+   const size_t partes = (size_t)(symplecticus ? 8 : 2);
+   size_t k;
+
+   pvi_c->servatum = 0;
+   if(pvi_arena_para(&pvi_c->densa, partes, N + 2 * L) != 0) return;
+   pvi_c->limbus = L;
+   for(k = (size_t)0; L > (size_t)0 && k < partes; ++k){
+      memset(pvi_arena_pars(&pvi_c->densa, k), 0, L * sizeof(PVI_CORPUS));
+      memset(pvi__densa(pvi_c, k) + N, 0, L * sizeof(PVI_CORPUS));
+   }
+   memcpy(pvi__densa(pvi_c, (size_t)0), pvi_c->x, N * sizeof(PVI_CORPUS));
+   if(symplecticus)
+      memcpy(pvi__densa(pvi_c, (size_t)1), pvi_c->y, N * sizeof(PVI_CORPUS));
+   pvi_c->tempus_prius = pvi_c->tempus;
+   pvi_c->servatum = 1;
+}
+
+/* Advances one step, returns -1 if the field was not given in a form
+   accepted by the method and -2 if PVI_DOPRI5, PVI_ABM_VARIABILIS or
+   PVI_KRYLOV could not meet the tolerances (the step fell below the
+   resolution of tempus). */
+PVI_FUNCTIO int pvi_progredere(pvi_contextus *pvi_c){
+   pvi_petitio p;
+
+   if(pvi_c->methodus < PVI_EULER_S){
+      if(pvi_c->punctum == NULL && pvi_c->campus == NULL) return -1;
+   }else if(pvi_c->fusus || pvi_c->methodus == PVI_RUTH4_FUSUS){
+      if(pvi_c->gradus_X == NULL || pvi_c->gradus_Y == NULL) return -1;
+   }else if(
+      (pvi_c->punctum_X == NULL && pvi_c->gradus_X == NULL) ||
+      (pvi_c->punctum_Y == NULL && pvi_c->gradus_Y == NULL)
+   ){
+      return -1;
+   }
+   if(pvi_c->densus) pvi__serva(pvi_c);
+   else pvi_c->servatum = 0;
+   while(pvi_pete(pvi_c, &p)) pvi__exsequere(pvi_c, &p);
+   if(pvi_c->defectus) pvi_c->servatum = 0;
+   return (pvi_c->defectus ? -2 : 0);
+}
+
+/* Integrates while tempus < finalis. After each step aliquid (if not NULL)
+   is called, a non-zero value stops the integration and is returned. */
+PVI_FUNCTIO int pvi_curre(pvi_contextus *pvi_c, double finalis,
+   int (*aliquid)(pvi_contextus *pvi_c)){
+   int status;
+
+   pvi_c->terminus = finalis;
+   while(pvi_c->tempus < finalis){
+      if((status = pvi_progredere(pvi_c)) != 0) return status;
+      if(aliquid != NULL && (status = aliquid(pvi_c)) != 0) return status;
+   }
+   return 0;
+}
+
+/* ------------------------------------
+   Funcoes genericas
+----------------------------------- */
+
+/* pvi_progredere and pvi_curre with the block form of the field given as
+   an argument instead of read from the context. Unlike the macros
+   PVI_INTEGRATOR_*, which paste a whole loop with a call per index at
+   every use, these are functions, but they are always inlined together
+   with the sweeps of the method: a callback named at the call site is
+   then called directly, so the compiler may inline it in the sweep,
+   specialise it and vectorise it across the block. They also store the
+   callbacks in the context, for pvi_interpola and the plain functions,
+   and return the same codes as pvi_progredere. With OpenMP the parallel
+   sweeps are outlined before inlining and call through pointers again. */
+PVI_INLINE int pvi_progredere_campus(pvi_contextus *pvi_c, pvi_campus campus){
+   pvi_petitio p;
+
+   if(pvi_c->methodus >= PVI_EULER_S || campus == NULL) return -1;
+   pvi_c->campus = campus;
+   if(pvi_c->densus) pvi__serva(pvi_c);
+   else pvi_c->servatum = 0;
+   while(pvi_pete(pvi_c, &p)) pvi__exsequere_campus(pvi_c, &p, campus);
+   if(pvi_c->defectus) pvi_c->servatum = 0;
+   return (pvi_c->defectus ? -2 : 0);
+}
+
+PVI_INLINE int pvi_progredere_gradus(pvi_contextus *pvi_c,
+   pvi_gradus gradus_X, pvi_gradus gradus_Y){
+   pvi_petitio p;
+
+   if(pvi_c->methodus < PVI_EULER_S || gradus_X == NULL || gradus_Y == NULL)
+      return -1;
+   pvi_c->gradus_X = gradus_X;
+   pvi_c->gradus_Y = gradus_Y;
+   if(pvi_c->densus) pvi__serva(pvi_c);
+   else pvi_c->servatum = 0;
+   if(pvi_c->fusus || pvi_c->methodus == PVI_RUTH4_FUSUS){
+      /* the bookkeeping of pvi_pete for a fused step */
+      pvi__ordo(pvi_c);
+      pvi__fusus_per(pvi_c, gradus_X, gradus_Y);
+      pvi_c->evaluationes += (unsigned long)pvi_c->ordo;
+      ++pvi_c->acceptati;
+      pvi_c->tempus += pvi_c->h;
+      return 0;
+   }
+   while(pvi_pete(pvi_c, &p))
+      pvi__exsequere_gradus(pvi_c, &p, gradus_X, gradus_Y);
+   return 0;
+}
+
+PVI_INLINE int pvi_curre_campus(pvi_contextus *pvi_c, double finalis,
+   int (*aliquid)(pvi_contextus *pvi_c), pvi_campus campus){
+   int status;
+
+   pvi_c->terminus = finalis;
+   while(pvi_c->tempus < finalis){
+      if((status = pvi_progredere_campus(pvi_c, campus)) != 0) return status;
+      if(aliquid != NULL && (status = aliquid(pvi_c)) != 0) return status;
+   }
+   return 0;
+}
+
+PVI_INLINE int pvi_curre_gradus(pvi_contextus *pvi_c, double finalis,
+   int (*aliquid)(pvi_contextus *pvi_c),
+   pvi_gradus gradus_X, pvi_gradus gradus_Y){
+   int status;
+
+   pvi_c->terminus = finalis;
+   while(pvi_c->tempus < finalis){
+      status = pvi_progredere_gradus(pvi_c, gradus_X, gradus_Y);
+      if(status != 0) return status;
+      if(aliquid != NULL && (status = aliquid(pvi_c)) != 0) return status;
+   }
+   return 0;
+}
+
+/* ------------------------------------
+   Saida densa
+----------------------------------- */
+
+/* Continuous extension of Dormand and Prince (Hairer, Norsett and Wanner,
+   Solving ODE I, II.6), of order 4, written as weights of the stages:
+   x(t0 + th hs) = x0 + hs sum_j w_j(th) k_j, with
+   w_j = th (1 - (1 - th) (1 - 2 th)) b_j + th^2 (1 - th)^2 d_j, plus
+   th (1 - th)^2 for k_1 and -th^2 (1 - th) for k_7. */
+static PVI__INUTILIS const double pvi__dopri5_d[7] = {
+   -12715105075.0 / 11282082432.0, 0.0, 87487479700.0 / 32700410799.0,
+   -10690763975.0 / 1880347072.0, 701980252875.0 / 199316789632.0,
+   -1453857185.0 / 822651844.0, 69997945.0 / 29380423.0
+};
+
+/* X[n] = X0[n] + sum_j b[j] K[j][n] */
+PVI_FUNCTIO void pvi__combina(size_t N, PVI_CORPUS *X, const PVI_CORPUS *X0,
+   const double *b, PVI_CORPUS *const *K, int m){
+   size_t n;
+
+   PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n){
+      PVI_CORPUS x = 0.0;
+      int j;
+      for(j = 0; j < m; ++j) x += K[j][n] * b[j];
+      X[n] = X0[n] + x;
+   }
+}
+
+/* Cubic Hermite interpolation between (X0, D0) and (X1, D1), D being the
+   derivatives multiplied by the length of the interval. */
+PVI_FUNCTIO void pvi__hermite(size_t N, double th, PVI_CORPUS *X,
+   const PVI_CORPUS *X0, const PVI_CORPUS *X1,
+   const PVI_CORPUS *D0, const PVI_CORPUS *D1, double H){
+   const double a0 = (1.0 + 2.0 * th) * (1.0 - th) * (1.0 - th);
+   const double a1 = th * th * (3.0 - 2.0 * th);
+   const double b0 = H * th * (1.0 - th) * (1.0 - th);
+   const double b1 = H * th * th * (th - 1.0);
+   size_t n;
+
+   PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n)
+      X[n] = X0[n] * a0 + X1[n] * a1 + D0[n] * b0 + D1[n] * b1;
+}
+
+/* Writes in X (and Y, for the symplectic methods) the state at the time t
+   of the last step, taken with densus set. The Runge-Kutta methods use
+   their continuous extensions (linear for PVI_EULER, quadratic for PVI_RK2,
+   cubic for PVI_RK4, of order 4 for PVI_DOPRI5) and PVI_ABM_VARIABILIS and
+   the symplectic methods the cubic Hermite interpolant of the values and
+   derivatives at both ends. PVI_KRYLOV is exact within the subspace of
+   the step, exp((t - t0) D) x0 taken from the same basis. For the
+   symplectic methods the derivatives cost four more sweeps of the field
+   (counted in evaluationes) for the first time asked in each step. The
+   end of the step is copied as it is. Returns -1 if the step was not
+   kept or t is outside of it. */
+PVI_FUNCTIO int pvi_interpola(pvi_contextus *pvi_c, double t,
+   PVI_CORPUS *X, PVI_CORPUS *Y){
+   const size_t N = pvi_c->dimensio;
+   const double t0 = pvi_c->tempus_prius, t1 = pvi_c->tempus;
+   PVI_CORPUS *X0 = pvi__densa(pvi_c, (size_t)0), *K[7];
+   PVI_CORPUS *V[PVI_KRYLOV_MAXIMUS];
+   double th, H, b[7], u, E[PVI__K2];
+   pvi_petitio p;
+   size_t n;
+   int j;
+
+   if(!pvi_c->servatum || !(t >= t0 && t <= t1)) return -1;
+   if(t == t1){
+      if(X != pvi_c->x) memcpy(X, pvi_c->x, N * sizeof(PVI_CORPUS));
+      if(pvi_c->methodus >= PVI_EULER_S && Y != pvi_c->y)
+         memcpy(Y, pvi_c->y, N * sizeof(PVI_CORPUS));
+      return 0;
+   }
+   H = (pvi_c->methodus == PVI_DOPRI5 || pvi_c->methodus == PVI_ABM_VARIABILIS ?
+      pvi_c->passus : pvi_c->h);
+   th = (t - t0) / (t1 - t0);
+
+   switch(pvi_c->methodus){
+      case PVI_EULER:
+         b[0] = H * th;
+         pvi__combina(N, X, X0, b, pvi_c->spatium, 1);
+         return 0;
+      case PVI_RK2:
+         b[0] = H * th * (1.0 - 0.5 * th);
+         b[1] = H * 0.5 * th * th;
+         pvi__combina(N, X, X0, b, pvi_c->spatium, 2);
+         return 0;
+      case PVI_RK4:
+         b[0] = H * th * (1.0 + th * (-1.5 + th * (2.0 / 3.0)));
+         b[1] = b[2] = H * th * th * (1.0 - th * (2.0 / 3.0));
+         b[3] = H * th * th * (-0.5 + th * (2.0 / 3.0));
+         pvi__combina(N, X, X0, b, pvi_c->spatium, 4);
+         return 0;
+      case PVI_DOPRI5:
+         /* after the step the slope at its end, k_7, sits in historia[0]
+            and k_1 in historia[6] */
+         u = th * (1.0 - (1.0 - th) * (1.0 - 2.0 * th));
+         for(j = 0; j < 7; ++j){
+            b[j] = H * ((j < 6 ? u * pvi__dopri5_a[6][j] : 0.0) +
+               th * th * (1.0 - th) * (1.0 - th) * pvi__dopri5_d[j]);
+            K[j] = pvi_c->historia[j == 0 ? 6 : j == 6 ? 0 : j];
+         }
+         b[0] += H * th * (1.0 - th) * (1.0 - th);
+         b[6] -= H * th * th * (1.0 - th);
+         pvi__combina(N, X, X0, b, K, 7);
+         return 0;
+      case PVI_ABM_VARIABILIS:
+         pvi__hermite(N, th, X, X0, pvi_c->x,
+            pvi_c->historia[1], pvi_c->historia[0], t1 - t0);
+         return 0;
+      case PVI_KRYLOV:
+         for(j = 0; j < pvi_c->subspatium; ++j)
+            V[j] = pvi_arena_pars(&pvi_c->arena, (size_t)j);
+         pvi__exponentialis(pvi_c->subspatium, pvi_c->hessenberg, t - t0, E);
+         pvi__krylov_combina(N, X, pvi_c->norma, E, V, pvi_c->subspatium);
+         return 0;
+   }
+
+   /* x' = punctum_X(y) and y' = punctum_Y(x), at both ends */
+   if(pvi_c->servatum == 1){
+      for(j = 2; j < 6; ++j){
+         p.quod = (j % 2 == 0 ? PVI_GRADUS_X : PVI_GRADUS_Y);
+         p.c = 1.0;
+         p.F = pvi__densa(pvi_c, (size_t)j);
+         p.argumentum = (j < 4 ?
+            pvi__densa(pvi_c, (size_t)(p.quod == PVI_GRADUS_X ? 1 : 0)) :
+            (p.quod == PVI_GRADUS_X ? pvi_c->y : pvi_c->x));
+         PVI_PARALLELE_SI(N) for(n = (size_t)0; n < N; ++n) p.F[n] = 0.0;
+         pvi__exsequere(pvi_c, &p);
+      }
+      pvi_c->evaluationes += 4UL;
+      pvi_c->servatum = 2;
+   }
+   pvi__hermite(N, th, X, X0, pvi_c->x, pvi__densa(pvi_c, (size_t)2),
+      pvi__densa(pvi_c, (size_t)4), t1 - t0);
+   pvi__hermite(N, th, Y, pvi__densa(pvi_c, (size_t)1), pvi_c->y,
+      pvi__densa(pvi_c, (size_t)3), pvi__densa(pvi_c, (size_t)5), t1 - t0);
+   return 0;
+}
+
+/* Integrates up to tempora[numerus - 1], the times being increasing and
+   not below tempus. After each step aliquid (if not NULL) is called as in
+   pvi_curre, and then exitus(pvi_c, k, X, Y) for every tempora[k] reached
+   by the step, with the state at that time (Y is NULL for the methods
+   without y). X and Y are x and y when the time falls on the end of the
+   step, otherwise arrays of the context that only hold until the next
+   step. A non-zero value of either callback stops the integration and is
+   returned. Only the steps that contain an output time are kept for the
+   interpolation, so densus is overwritten. */
+PVI_FUNCTIO int pvi_curre_densus(pvi_contextus *pvi_c, const double *tempora,
+   size_t numerus, int (*aliquid)(pvi_contextus *pvi_c),
+   int (*exitus)(pvi_contextus *pvi_c, size_t k, PVI_CORPUS *X, PVI_CORPUS *Y)){
+   const int symplecticus = (pvi_c->methodus >= PVI_EULER_S);
+   const size_t S = (size_t)(symplecticus ? 6 : 1);
+   PVI_CORPUS *X, *Y;
+   size_t k = (size_t)0;
+   int status;
+
+   if(numerus == (size_t)0) return 0;
+   pvi_c->terminus = tempora[numerus - 1];
+   for(;;){
+      for(; k < numerus && tempora[k] <= pvi_c->tempus; ++k){
+         X = pvi_c->x;
+         Y = (symplecticus ? pvi_c->y : NULL);
+         if(tempora[k] < pvi_c->tempus && pvi_c->servatum){
+            X = pvi__densa(pvi_c, S);
+            if(symplecticus) Y = pvi__densa(pvi_c, S + 1);
+            if(pvi_interpola(pvi_c, tempora[k], X, Y) != 0){
+               X = pvi_c->x;
+               Y = (symplecticus ? pvi_c->y : NULL);
+            }
+         }
+         if((status = exitus(pvi_c, k, X, Y)) != 0) return status;
+      }
+      if(k == numerus) return 0;
+      pvi_c->densus = (tempora[k] <= pvi_c->tempus + pvi_c->h);
+      if((status = pvi_progredere(pvi_c)) != 0) return status;
+      if(aliquid != NULL && (status = aliquid(pvi_c)) != 0) return status;
+   }
+}
+
+/* The macros below are thin wrappers over the context: the field is still
+   evaluated inline, at the points asked by pvi_pete, and after each step
+   PVI_FAC_ALIQUID() may `continue` or `break` the loop over the steps.
+   Each method keeps its context between calls, so that the workspace is
+   allocated only when pvi_dimensio grows, and likewise the multistep
+   macros share one arena for their slopes (the macros are not reentrant
+   anyway, they read pvi_dimensio, pvi_h and pvi_finalis). pvi_libera
+   releases this memory. */
+static PVI__INUTILIS pvi_contextus *pvi__contextus[PVI__METHODI];
+static PVI__INUTILIS pvi_arena pvi__arena_multipassus;
+
+PVI_FUNCTIO pvi_contextus *pvi__contextus_macri(int methodus){
+   pvi_contextus *pvi_c = pvi__contextus[methodus];
+
+   if(pvi_c == NULL || pvi_c->dimensio < pvi_dimensio){
+      pvi_destrue(pvi_c);
+      pvi_c = pvi__contextus[methodus] = pvi_crea(methodus, pvi_dimensio, pvi_h);
+      if(pvi_c == NULL){
+         pvi_defectus = 1;
+         return NULL;
+      }
+   }
+   pvi_defectus = 0;
+   pvi_c->dimensio = pvi_dimensio;
+   pvi_c->h = pvi_h;
+   pvi_c->terminus = pvi_finalis;
+   pvi_c->tolerantia_absoluta = pvi_c->tolerantia_relativa = pvi_tolerantia;
+   pvi_c->acceptati = pvi_c->rejecti = pvi_c->evaluationes = 0UL;
+   pvi_obliviscere(pvi_c);
+   return pvi_c;
+}
+
+PVI_FUNCTIO void pvi__numera(const pvi_contextus *pvi_c){
+   pvi_acceptati = pvi_c->acceptati;
+   pvi_rejecti = pvi_c->rejecti;
+   pvi_evaluationes = pvi_c->evaluationes;
+   pvi_defectus = pvi_c->defectus;
+}
+
+/* The slopes of a multistep macro and the context of the Runge-Kutta
+   method that starts its history (none if `initium` < 0), both obtained
+   before X is touched: on failure the macro leaves X and t unchanged. */
+PVI_FUNCTIO int pvi__multipassus(size_t partes, int initium){
+   pvi_defectus =
+      (pvi_arena_para(&pvi__arena_multipassus, partes, pvi_dimensio) != 0 ||
+      (initium >= 0 && pvi__contextus_macri(initium) == NULL));
+   return pvi_defectus;
+}
+#define PVI__MULTIPASSUS(k) pvi_arena_pars(&pvi__arena_multipassus, (size_t)(k))
+
+/* The history of the multistep methods is a ring of pointers: at the end
+   of each step the oldest slope array becomes the newest one, instead of
+   copying every slope one place back. */
+PVI_FUNCTIO void pvi__roda(PVI_CORPUS **inclinatio, size_t K){
+   PVI_CORPUS *antiquissima = inclinatio[0];
+   size_t k;
+
+   for(k = (size_t)1; k < K; ++k) inclinatio[k - 1] = inclinatio[k];
+   inclinatio[K - 1] = antiquissima;
+}
+
+PVI_FUNCTIO void pvi_libera(void){
+   int k;
+   for(k = 0; k < PVI__METHODI; ++k){
+      pvi_destrue(pvi__contextus[k]);
+      pvi__contextus[k] = NULL;
+   }
+   pvi_arena_libera(&pvi__arena_multipassus);
+}
+#define PVI__CAMPUS(t, X, X_punctum, methodus) \
 {\
    size_t pvi_index;\
-   double pvi_h2;\
-   PVI_CORPUS \
-      *pvi_inclinatio[2] = { NULL, NULL },\
-      *pvi_Xaux = NULL;\
-\
-   pvi_inclinatio[0] = PVI_ALLOCARE();\
-   pvi_inclinatio[1] = PVI_ALLOCARE();\
-   pvi_Xaux = PVI_ALLOCARE();\
-\
-   pvi_h2 = 0.5 * pvi_h;\
-\
-   while(t < pvi_finalis){\
-\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
-         pvi_Xaux[pvi_index] = \
-            (X)[pvi_index] + pvi_inclinatio[0][pvi_index] * pvi_h;\
+   pvi_petitio pvi_p;\
+   pvi_contextus *pvi_c = pvi__contextus_macri(methodus);\
+\
+   if(pvi_c != NULL){\
+      pvi_c->tempus = t;\
+      pvi_c->x = (X);\
+      while(t < pvi_finalis){\
+         while(pvi_pete(pvi_c, &pvi_p)){\
+            if(pvi_p.Z == NULL){\
+               PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+                  pvi_p.F[pvi_index] = \
+                     X_punctum(pvi_index, pvi_p.tempus, pvi_p.argumentum);\
+            }else{\
+               PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+                  pvi_p.F[pvi_index] = \
+                     X_punctum(pvi_index, pvi_p.tempus, pvi_p.argumentum);\
+                  pvi_p.Z[pvi_index] = \
+                     pvi_p.B[pvi_index] + pvi_p.F[pvi_index] * pvi_p.c;\
+               }\
+            }\
+         }\
+         if(pvi_c->defectus) break;\
+         t = pvi_c->tempus;\
+         PVI_FAC_ALIQUID();\
       }\
-      t += pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         (X)[pvi_index] += pvi_h2 * \
-            (pvi_inclinatio[0][pvi_index] + pvi_inclinatio[1][pvi_index]);\
-      }\
-      PVI_FAC_ALIQUID();\
+      pvi__numera(pvi_c);\
    }\
-   free(pvi_inclinatio[0]);\
-   free(pvi_inclinatio[1]);\
-   free(pvi_Xaux);\
 }
 
-#define PVI_INTEGRATOR_RK4(t, X, X_punctum) \
+#define PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, methodus) \
 {\
    size_t pvi_index;\
-   double pvi_h2, pvi_h6;\
-   double pvi__t_aux;\
-   PVI_CORPUS \
-      *pvi_inclinatio[4] = { NULL, NULL, NULL, NULL },\
-      *pvi_Xaux[2] = {NULL, NULL};\
-\
-   (void)pvi__t_aux;\
-\
-   pvi_inclinatio[0] = PVI_ALLOCARE();\
-   pvi_inclinatio[1] = PVI_ALLOCARE();\
-   pvi_inclinatio[2] = PVI_ALLOCARE();\
-   pvi_inclinatio[3] = PVI_ALLOCARE();\
-   pvi_Xaux[0] = PVI_ALLOCARE();\
-   pvi_Xaux[1] = PVI_ALLOCARE();\
-\
-   pvi_h2 = 0.5 * pvi_h;\
-   pvi_h6 = pvi_h / 6.0;\
-\
-   while(t < pvi_finalis){\
-\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
-         pvi_Xaux[0][pvi_index] = \
-            (X)[pvi_index] + pvi_inclinatio[0][pvi_index] * pvi_h2;\
-      }\
-      pvi__t_aux = t + pvi_h2;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_inclinatio[1][pvi_index] = \
-            X_punctum(pvi_index, pvi__t_aux, pvi_Xaux[0]);\
-         pvi_Xaux[1][pvi_index] = \
-            (X)[pvi_index] + pvi_inclinatio[1][pvi_index] * pvi_h2;\
+   pvi_petitio pvi_p;\
+   pvi_contextus *pvi_c = pvi__contextus_macri(methodus);\
+\
+   if(pvi_c != NULL){\
+      pvi_c->tempus = t;\
+      pvi_c->x = (X);\
+      pvi_c->y = (Y);\
+      while(t < pvi_finalis){\
+         while(pvi_pete(pvi_c, &pvi_p)){\
+            if(pvi_p.quod == PVI_GRADUS_X){\
+               PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+                  pvi_p.F[pvi_index] += \
+                     X_punctum(pvi_index, pvi_p.argumentum) * pvi_p.c;\
+            }else{\
+               PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+                  pvi_p.F[pvi_index] += \
+                     Y_punctum(pvi_index, pvi_p.argumentum) * pvi_p.c;\
+            }\
+         }\
+         t = pvi_c->tempus;\
+         PVI_FAC_ALIQUID();\
       }\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_inclinatio[2][pvi_index] = \
-            X_punctum(pvi_index, pvi__t_aux, pvi_Xaux[1]);\
-         pvi_Xaux[0][pvi_index] = \
-            (X)[pvi_index] + pvi_inclinatio[2][pvi_index] * pvi_h;\
-      }\
-      t += pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, pvi_Xaux[0]);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         (X)[pvi_index] += pvi_h6 * (\
-            pvi_inclinatio[0][pvi_index] + pvi_inclinatio[3][pvi_index] +\
-            2.0 * (pvi_inclinatio[1][pvi_index] + pvi_inclinatio[2][pvi_index])\
-          );\
+      pvi__numera(pvi_c);\
+   }\
+}
+
+#define PVI__BLOCUS(t, X, Y, X_gradus, Y_gradus, methodus) \
+{\
+   int pvi_status = 0;\
+   pvi_contextus *pvi_c = pvi__contextus_macri(methodus);\
+\
+   if(pvi_c != NULL){\
+      pvi_c->tempus = t;\
+      pvi_c->x = (X);\
+      pvi_c->y = (Y);\
+      pvi_c->gradus_X = X_gradus;\
+      pvi_c->gradus_Y = Y_gradus;\
+      pvi_c->blocus = PVI_BLOCUS;\
+      while(t < pvi_finalis){\
+         /* a NULL callback is refused without advancing the time */\
+         if((pvi_status = pvi_progredere(pvi_c)) != 0) break;\
+         t = pvi_c->tempus;\
+         PVI_FAC_ALIQUID();\
       }\
-      PVI_FAC_ALIQUID();\
+      pvi__numera(pvi_c);\
+      if(pvi_status != 0) pvi_defectus = 1;\
    }\
-   free(pvi_inclinatio[0]);\
-   free(pvi_inclinatio[1]);\
-   free(pvi_inclinatio[2]);\
-   free(pvi_inclinatio[3]);\
-   free(pvi_Xaux[0]);\
-   free(pvi_Xaux[1]);\
 }
 
+/* ------------------------------------
+   Metodos de Runge-Kutta
+----------------------------------- */
+
+#define PVI_INTEGRATOR_EULER(t, X, X_punctum) \
+   PVI__CAMPUS(t, X, X_punctum, PVI_EULER)
+
+#define PVI_INTEGRATOR_RK2(t, X, X_punctum) \
+   PVI__CAMPUS(t, X, X_punctum, PVI_RK2)
+
+#define PVI_INTEGRATOR_RK4(t, X, X_punctum) \
+   PVI__CAMPUS(t, X, X_punctum, PVI_RK4)
+
 
 
 /* ------------------------------------
@@ -193,36 +2004,35 @@ static double pvi_h = 0.25, pvi_finalis = 1.0;
    PVI_CORPUS \
       *pvi_inclinatio[2] = { NULL, NULL };\
 \
-   pvi_inclinatio[0] = PVI_ALLOCARE();\
-   pvi_inclinatio[1] = PVI_ALLOCARE();\
-\
-   pvi_hh[0] = - 0.5 * pvi_h;\
-   pvi_hh[1] = 1.5 * pvi_h;\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
+   if(pvi__multipassus((size_t)2, PVI_RK2) == 0){\
+      pvi_inclinatio[0] = PVI__MULTIPASSUS(0);\
+      pvi_inclinatio[1] = PVI__MULTIPASSUS(1);\
 \
-   pvi_finalis1 = pvi_finalis;\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK2(t, X, X_punctum);\
-   pvi_finalis = pvi_finalis1;\
+      pvi_hh[0] = - 0.5 * pvi_h;\
+      pvi_hh[1] = 1.5 * pvi_h;\
 \
-   while(t < pvi_finalis){\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
 \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         (X)[pvi_index] += \
-            pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
+      pvi_finalis1 = pvi_finalis;\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK2(t, X, X_punctum);\
+      pvi_finalis = pvi_finalis1;\
+\
+      while(t < pvi_finalis){\
+\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            (X)[pvi_index] += \
+               pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
+         }\
+         t += pvi_h;\
+         pvi__roda(pvi_inclinatio, (size_t)2);\
+         PVI_FAC_ALIQUID();\
       }\
-      t += pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[0][pvi_index] = pvi_inclinatio[1][pvi_index];\
-      PVI_FAC_ALIQUID();\
    }\
-   free(pvi_inclinatio[0]);\
-   free(pvi_inclinatio[1]);\
 }
 
 /* https://en.wikiversity.org/wiki/Adams-Bashforth_and_Adams-Moulton_methods */
@@ -233,47 +2043,43 @@ static double pvi_h = 0.25, pvi_finalis = 1.0;
    PVI_CORPUS \
       *pvi_inclinatio[3] = { NULL, NULL, NULL };\
 \
-   pvi_inclinatio[0] = PVI_ALLOCARE();\
-   pvi_inclinatio[1] = PVI_ALLOCARE();\
-   pvi_inclinatio[2] = PVI_ALLOCARE();\
-\
-   pvi_hh[0] = pvi_h * 5.0 / 12.0;\
-   pvi_hh[1] = pvi_h * (-4.0 / 3.0);\
-   pvi_hh[2] = pvi_h * 23.0 / 12.0;\
+   if(pvi__multipassus((size_t)3, PVI_RK4) == 0){\
+      pvi_inclinatio[0] = PVI__MULTIPASSUS(0);\
+      pvi_inclinatio[1] = PVI__MULTIPASSUS(1);\
+      pvi_inclinatio[2] = PVI__MULTIPASSUS(2);\
 \
-   pvi_finalis1 = pvi_finalis;\
+      pvi_hh[0] = pvi_h * 5.0 / 12.0;\
+      pvi_hh[1] = pvi_h * (-4.0 / 3.0);\
+      pvi_hh[2] = pvi_h * 23.0 / 12.0;\
 \
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+      pvi_finalis1 = pvi_finalis;\
 \
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-   pvi_finalis = pvi_finalis1;\
-\
-   while(t < pvi_finalis){\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
 \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         (X)[pvi_index] += \
-            pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
-      }\
-      t += pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_inclinatio[0][pvi_index] = pvi_inclinatio[1][pvi_index];\
-         pvi_inclinatio[1][pvi_index] = pvi_inclinatio[2][pvi_index];\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+      pvi_finalis = pvi_finalis1;\
+\
+      while(t < pvi_finalis){\
+\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            (X)[pvi_index] += \
+               pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
+         }\
+         t += pvi_h;\
+         pvi__roda(pvi_inclinatio, (size_t)3);\
+         PVI_FAC_ALIQUID();\
       }\
-      PVI_FAC_ALIQUID();\
    }\
-   free(pvi_inclinatio[0]);\
-   free(pvi_inclinatio[1]);\
-   free(pvi_inclinatio[2]);\
 }
 
 #define PVI_INTEGRATOR_AB4(t, X, X_punctum) \
@@ -283,57 +2089,51 @@ static double pvi_h = 0.25, pvi_finalis = 1.0;
    PVI_CORPUS \
       *pvi_inclinatio[4] = { NULL, NULL, NULL, NULL };\
 \
-   pvi_inclinatio[0] = PVI_ALLOCARE();\
-   pvi_inclinatio[1] = PVI_ALLOCARE();\
-   pvi_inclinatio[2] = PVI_ALLOCARE();\
-   pvi_inclinatio[3] = PVI_ALLOCARE();\
-\
-   pvi_hh[0] = pvi_h * (-9.0 / 24.0);\
-   pvi_hh[1] = pvi_h * (37.0 / 24.0);\
-   pvi_hh[2] = pvi_h * (-59.0 / 24.0);\
-   pvi_hh[3] = pvi_h * (55.0 / 24.0);\
-\
-   pvi_finalis1 = pvi_finalis;\
+   if(pvi__multipassus((size_t)4, PVI_RK4) == 0){\
+      pvi_inclinatio[0] = PVI__MULTIPASSUS(0);\
+      pvi_inclinatio[1] = PVI__MULTIPASSUS(1);\
+      pvi_inclinatio[2] = PVI__MULTIPASSUS(2);\
+      pvi_inclinatio[3] = PVI__MULTIPASSUS(3);\
 \
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+      pvi_hh[0] = pvi_h * (-9.0 / 24.0);\
+      pvi_hh[1] = pvi_h * (37.0 / 24.0);\
+      pvi_hh[2] = pvi_h * (-59.0 / 24.0);\
+      pvi_hh[3] = pvi_h * (55.0 / 24.0);\
 \
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+      pvi_finalis1 = pvi_finalis;\
 \
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-   pvi_finalis = pvi_finalis1;\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
 \
-   while(t < pvi_finalis){\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
 \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, X);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         (X)[pvi_index] += \
-            pvi_inclinatio[3][pvi_index] * pvi_hh[3] + \
-            pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
-      }\
-      t += pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_inclinatio[0][pvi_index] = pvi_inclinatio[1][pvi_index];\
-         pvi_inclinatio[1][pvi_index] = pvi_inclinatio[2][pvi_index];\
-         pvi_inclinatio[2][pvi_index] = pvi_inclinatio[3][pvi_index];\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+      pvi_finalis = pvi_finalis1;\
+\
+      while(t < pvi_finalis){\
+\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, X);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            (X)[pvi_index] += \
+               pvi_inclinatio[3][pvi_index] * pvi_hh[3] + \
+               pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
+         }\
+         t += pvi_h;\
+         pvi__roda(pvi_inclinatio, (size_t)4);\
+         PVI_FAC_ALIQUID();\
       }\
-      PVI_FAC_ALIQUID();\
    }\
-   free(pvi_inclinatio[0]);\
-   free(pvi_inclinatio[1]);\
-   free(pvi_inclinatio[2]);\
-   free(pvi_inclinatio[3]);\
 }
 
 #define PVI_INTEGRATOR_AB5(t, X, X_punctum) \
@@ -343,67 +2143,59 @@ static double pvi_h = 0.25, pvi_finalis = 1.0;
    PVI_CORPUS \
       *pvi_inclinatio[5] = { NULL, NULL, NULL, NULL, NULL };\
 \
-   pvi_inclinatio[0] = PVI_ALLOCARE();\
-   pvi_inclinatio[1] = PVI_ALLOCARE();\
-   pvi_inclinatio[2] = PVI_ALLOCARE();\
-   pvi_inclinatio[3] = PVI_ALLOCARE();\
-   pvi_inclinatio[4] = PVI_ALLOCARE();\
-\
-   pvi_hh[0] = pvi_h * 251.0 / 720.0;\
-   pvi_hh[1] = pvi_h * (-1274.0 / 720.0);\
-   pvi_hh[2] = pvi_h * 2616.0 / 720.0;\
-   pvi_hh[3] = pvi_h * (-2774.0 / 720.0);\
-   pvi_hh[4] = pvi_h * 1901.0 / 720.0;\
-\
-   pvi_finalis1 = pvi_finalis;\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-   pvi_finalis = pvi_finalis1;\
+   if(pvi__multipassus((size_t)5, PVI_RK4) == 0){\
+      pvi_inclinatio[0] = PVI__MULTIPASSUS(0);\
+      pvi_inclinatio[1] = PVI__MULTIPASSUS(1);\
+      pvi_inclinatio[2] = PVI__MULTIPASSUS(2);\
+      pvi_inclinatio[3] = PVI__MULTIPASSUS(3);\
+      pvi_inclinatio[4] = PVI__MULTIPASSUS(4);\
 \
-   while(t < pvi_finalis){\
+      pvi_hh[0] = pvi_h * 251.0 / 720.0;\
+      pvi_hh[1] = pvi_h * (-1274.0 / 720.0);\
+      pvi_hh[2] = pvi_h * 2616.0 / 720.0;\
+      pvi_hh[3] = pvi_h * (-2774.0 / 720.0);\
+      pvi_hh[4] = pvi_h * 1901.0 / 720.0;\
 \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[4][pvi_index] = X_punctum(pvi_index, t, X);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         (X)[pvi_index] += \
-            pvi_inclinatio[4][pvi_index] * pvi_hh[4] + \
-            pvi_inclinatio[3][pvi_index] * pvi_hh[3] + \
-            pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
-      }\
-      t += pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_inclinatio[0][pvi_index] = pvi_inclinatio[1][pvi_index];\
-         pvi_inclinatio[1][pvi_index] = pvi_inclinatio[2][pvi_index];\
-         pvi_inclinatio[2][pvi_index] = pvi_inclinatio[3][pvi_index];\
-         pvi_inclinatio[3][pvi_index] = pvi_inclinatio[4][pvi_index];\
+      pvi_finalis1 = pvi_finalis;\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+      pvi_finalis = pvi_finalis1;\
+\
+      while(t < pvi_finalis){\
+\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[4][pvi_index] = X_punctum(pvi_index, t, X);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            (X)[pvi_index] += \
+               pvi_inclinatio[4][pvi_index] * pvi_hh[4] + \
+               pvi_inclinatio[3][pvi_index] * pvi_hh[3] + \
+               pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
+         }\
+         t += pvi_h;\
+         pvi__roda(pvi_inclinatio, (size_t)5);\
+         PVI_FAC_ALIQUID();\
       }\
-      PVI_FAC_ALIQUID();\
    }\
-   free(pvi_inclinatio[0]);\
-   free(pvi_inclinatio[1]);\
-   free(pvi_inclinatio[2]);\
-   free(pvi_inclinatio[3]);\
-   free(pvi_inclinatio[4]);\
 }
 
 /* Dr. F.A.B.F. de Moura */
@@ -416,117 +2208,99 @@ static double pvi_h = 0.25, pvi_finalis = 1.0;
       NULL, NULL, NULL, NULL, NULL, \
       NULL, NULL, NULL, NULL, NULL };\
 \
-   pvi_inclinatio[0] = PVI_ALLOCARE();\
-   pvi_inclinatio[1] = PVI_ALLOCARE();\
-   pvi_inclinatio[2] = PVI_ALLOCARE();\
-   pvi_inclinatio[3] = PVI_ALLOCARE();\
-   pvi_inclinatio[4] = PVI_ALLOCARE();\
-   pvi_inclinatio[5] = PVI_ALLOCARE();\
-   pvi_inclinatio[6] = PVI_ALLOCARE();\
-   pvi_inclinatio[7] = PVI_ALLOCARE();\
-   pvi_inclinatio[8] = PVI_ALLOCARE();\
-   pvi_inclinatio[9] = PVI_ALLOCARE();\
-\
-   pvi_hh[0] = pvi_h * (-2082753.0 / 7257600.0);\
-   pvi_hh[1] = pvi_h * (20884811.0 / 7257600.0);\
-   pvi_hh[2] = pvi_h * (-94307320.0 / 7257600.0);\
-   pvi_hh[3] = pvi_h * (252618224.0 / 7257600.0);\
-   pvi_hh[4] = pvi_h * (-444772162.0 / 7257600.0);\
-   pvi_hh[5] = pvi_h * (538363838.0 / 7257600.0);\
-   pvi_hh[6] = pvi_h * (-454661776.0 / 7257600.0);\
-   pvi_hh[7] = pvi_h * (265932680.0 / 7257600.0);\
-   pvi_hh[8] = pvi_h * (-104995189.0 / 7257600.0);\
-   pvi_hh[9] = pvi_h * (30277247.0 / 7257600.0);\
-\
-   pvi_finalis1 = pvi_finalis;\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[4][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[5][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[6][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[7][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[8][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-   pvi_finalis = pvi_finalis1;\
+   if(pvi__multipassus((size_t)10, PVI_RK4) == 0){\
+      pvi_inclinatio[0] = PVI__MULTIPASSUS(0);\
+      pvi_inclinatio[1] = PVI__MULTIPASSUS(1);\
+      pvi_inclinatio[2] = PVI__MULTIPASSUS(2);\
+      pvi_inclinatio[3] = PVI__MULTIPASSUS(3);\
+      pvi_inclinatio[4] = PVI__MULTIPASSUS(4);\
+      pvi_inclinatio[5] = PVI__MULTIPASSUS(5);\
+      pvi_inclinatio[6] = PVI__MULTIPASSUS(6);\
+      pvi_inclinatio[7] = PVI__MULTIPASSUS(7);\
+      pvi_inclinatio[8] = PVI__MULTIPASSUS(8);\
+      pvi_inclinatio[9] = PVI__MULTIPASSUS(9);\
+\
+      pvi_hh[0] = pvi_h * (-2082753.0 / 7257600.0);\
+      pvi_hh[1] = pvi_h * (20884811.0 / 7257600.0);\
+      pvi_hh[2] = pvi_h * (-94307320.0 / 7257600.0);\
+      pvi_hh[3] = pvi_h * (252618224.0 / 7257600.0);\
+      pvi_hh[4] = pvi_h * (-444772162.0 / 7257600.0);\
+      pvi_hh[5] = pvi_h * (538363838.0 / 7257600.0);\
+      pvi_hh[6] = pvi_h * (-454661776.0 / 7257600.0);\
+      pvi_hh[7] = pvi_h * (265932680.0 / 7257600.0);\
+      pvi_hh[8] = pvi_h * (-104995189.0 / 7257600.0);\
+      pvi_hh[9] = pvi_h * (30277247.0 / 7257600.0);\
+\
+      pvi_finalis1 = pvi_finalis;\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
 \
-   while(t < pvi_finalis){\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
 \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[9][pvi_index] = X_punctum(pvi_index, t, X);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         (X)[pvi_index] += \
-            pvi_inclinatio[9][pvi_index] * pvi_hh[9] + \
-            pvi_inclinatio[8][pvi_index] * pvi_hh[8] + \
-            pvi_inclinatio[7][pvi_index] * pvi_hh[7] + \
-            pvi_inclinatio[6][pvi_index] * pvi_hh[6] + \
-            pvi_inclinatio[5][pvi_index] * pvi_hh[5] + \
-            pvi_inclinatio[4][pvi_index] * pvi_hh[4] + \
-            pvi_inclinatio[3][pvi_index] * pvi_hh[3] + \
-            pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
-      }\
-      t += pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_inclinatio[0][pvi_index] = pvi_inclinatio[1][pvi_index];\
-         pvi_inclinatio[1][pvi_index] = pvi_inclinatio[2][pvi_index];\
-         pvi_inclinatio[2][pvi_index] = pvi_inclinatio[3][pvi_index];\
-         pvi_inclinatio[3][pvi_index] = pvi_inclinatio[4][pvi_index];\
-         pvi_inclinatio[4][pvi_index] = pvi_inclinatio[5][pvi_index];\
-         pvi_inclinatio[5][pvi_index] = pvi_inclinatio[6][pvi_index];\
-         pvi_inclinatio[6][pvi_index] = pvi_inclinatio[7][pvi_index];\
-         pvi_inclinatio[7][pvi_index] = pvi_inclinatio[8][pvi_index];\
-         pvi_inclinatio[8][pvi_index] = pvi_inclinatio[9][pvi_index];\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[4][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[5][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[6][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[7][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[8][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+      pvi_finalis = pvi_finalis1;\
+\
+      while(t < pvi_finalis){\
+\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[9][pvi_index] = X_punctum(pvi_index, t, X);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            (X)[pvi_index] += \
+               pvi_inclinatio[9][pvi_index] * pvi_hh[9] + \
+               pvi_inclinatio[8][pvi_index] * pvi_hh[8] + \
+               pvi_inclinatio[7][pvi_index] * pvi_hh[7] + \
+               pvi_inclinatio[6][pvi_index] * pvi_hh[6] + \
+               pvi_inclinatio[5][pvi_index] * pvi_hh[5] + \
+               pvi_inclinatio[4][pvi_index] * pvi_hh[4] + \
+               pvi_inclinatio[3][pvi_index] * pvi_hh[3] + \
+               pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
+         }\
+         t += pvi_h;\
+         pvi__roda(pvi_inclinatio, (size_t)10);\
+         PVI_FAC_ALIQUID();\
       }\
-      PVI_FAC_ALIQUID();\
    }\
-   free(pvi_inclinatio[0]);\
-   free(pvi_inclinatio[1]);\
-   free(pvi_inclinatio[2]);\
-   free(pvi_inclinatio[3]);\
-   free(pvi_inclinatio[4]);\
-   free(pvi_inclinatio[5]);\
-   free(pvi_inclinatio[6]);\
-   free(pvi_inclinatio[7]);\
-   free(pvi_inclinatio[8]);\
-   free(pvi_inclinatio[9]);\
 }
 
 /* ------------------------------------
@@ -538,26 +2312,26 @@ static double pvi_h = 0.25, pvi_finalis = 1.0;
    size_t pvi_index;\
    PVI_CORPUS *pvi_inclinatio = NULL, *pvi_Xaux = NULL;\
 \
-   pvi_inclinatio = PVI_ALLOCARE();\
-   pvi_Xaux = PVI_ALLOCARE();\
-\
-   while(t < pvi_finalis){\
-      /* ----- Preditor ----- */ \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[pvi_index] = X_punctum(pvi_index, t, X);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_Xaux[pvi_index] = \
-         (X)[pvi_index] +  pvi_inclinatio[pvi_index] * pvi_h;\
-      t += pvi_h;\
-      /* ----- Corretor ----- */ \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (X)[pvi_index] += pvi_inclinatio[pvi_index] * pvi_h;\
-      PVI_FAC_ALIQUID();\
+   if(pvi__multipassus((size_t)2, -1) == 0){\
+      pvi_inclinatio = PVI__MULTIPASSUS(0);\
+      pvi_Xaux = PVI__MULTIPASSUS(1);\
+\
+      while(t < pvi_finalis){\
+         /* ----- Preditor ----- */ \
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[pvi_index] = X_punctum(pvi_index, t, X);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_Xaux[pvi_index] = \
+            (X)[pvi_index] +  pvi_inclinatio[pvi_index] * pvi_h;\
+         t += pvi_h;\
+         /* ----- Corretor ----- */ \
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            (X)[pvi_index] += pvi_inclinatio[pvi_index] * pvi_h;\
+         PVI_FAC_ALIQUID();\
+      }\
    }\
-   free(pvi_inclinatio);\
-   free(pvi_Xaux);\
 }
 
 #define PVI_INTEGRATOR_ABM2(t, X, X_punctum) \
@@ -567,49 +2341,47 @@ static double pvi_h = 0.25, pvi_finalis = 1.0;
    PVI_CORPUS \
       *pvi_inclinatio[2] = { NULL, NULL }, *pvi_Xaux;\
 \
-   pvi_inclinatio[0] = PVI_ALLOCARE();\
-   pvi_inclinatio[1] = PVI_ALLOCARE();\
-   pvi_Xaux = PVI_ALLOCARE();\
-   /* Coeficiente de Adans-Bashforth */\
-   pvi_hh[0] = pvi_h * (-0.5);\
-   pvi_hh[1] = pvi_h * 1.5;\
-   /* Coeficiente de Adans-Moulton */\
-   pvi_hhh[0] = pvi_h * 0.5;\
-   pvi_hhh[1] = pvi_h * 0.5;\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
-\
-   pvi_finalis1 = pvi_finalis;\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK2(t, X, X_punctum);\
-   pvi_finalis = pvi_finalis1;\
+   if(pvi__multipassus((size_t)3, PVI_RK2) == 0){\
+      pvi_inclinatio[0] = PVI__MULTIPASSUS(0);\
+      pvi_inclinatio[1] = PVI__MULTIPASSUS(1);\
+      pvi_Xaux = PVI__MULTIPASSUS(2);\
+      /* Coeficiente de Adans-Bashforth */\
+      pvi_hh[0] = pvi_h * (-0.5);\
+      pvi_hh[1] = pvi_h * 1.5;\
+      /* Coeficiente de Adans-Moulton */\
+      pvi_hhh[0] = pvi_h * 0.5;\
+      pvi_hhh[1] = pvi_h * 0.5;\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
 \
-   while(t < pvi_finalis){\
-      /* ----- Preditor ----- */ \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_Xaux[pvi_index] = (X)[pvi_index] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
+      pvi_finalis1 = pvi_finalis;\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK2(t, X, X_punctum);\
+      pvi_finalis = pvi_finalis1;\
+\
+      while(t < pvi_finalis){\
+         /* ----- Preditor ----- */ \
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            pvi_Xaux[pvi_index] = (X)[pvi_index] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
+         }\
+         t += pvi_h;\
+         pvi__roda(pvi_inclinatio, (size_t)2);\
+         /* ----- Corretor ----- */ \
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            (X)[pvi_index] += \
+               pvi_inclinatio[1][pvi_index] * pvi_hhh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hhh[0];\
+         }\
+         PVI_FAC_ALIQUID();\
       }\
-      t += pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[0][pvi_index] = pvi_inclinatio[1][pvi_index];\
-      /* ----- Corretor ----- */ \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         (X)[pvi_index] += \
-            pvi_inclinatio[1][pvi_index] * pvi_hhh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hhh[0];\
-      }\
-      PVI_FAC_ALIQUID();\
    }\
-   free(pvi_inclinatio[0]);\
-   free(pvi_inclinatio[1]);\
-   free(pvi_Xaux);\
 }
 
 #define PVI_INTEGRATOR_ABM3(t, X, X_punctum) \
@@ -619,62 +2391,57 @@ static double pvi_h = 0.25, pvi_finalis = 1.0;
    PVI_CORPUS \
       *pvi_inclinatio[3] = { NULL, NULL, NULL }, *pvi_Xaux;\
 \
-   pvi_inclinatio[0] = PVI_ALLOCARE();\
-   pvi_inclinatio[1] = PVI_ALLOCARE();\
-   pvi_inclinatio[2] = PVI_ALLOCARE();\
-   pvi_Xaux = PVI_ALLOCARE();\
-   /* Coeficiente de Adans-Bashforth */\
-   pvi_hh[0] = pvi_h * 5.0 / 12.0;\
-   pvi_hh[1] = pvi_h * (-4.0 / 3.0);\
-   pvi_hh[2] = pvi_h * 23.0 / 12.0;\
-   /* Coeficiente de Adans-Moulton */\
-   pvi_hhh[0] = pvi_h * (-1.0 / 12.0);\
-   pvi_hhh[1] = pvi_h * (8.0 / 12.0);\
-   pvi_hhh[2] = pvi_h * (5.0 / 12.0);\
-\
-   pvi_finalis1 = pvi_finalis;\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-   pvi_finalis = pvi_finalis1;\
+   if(pvi__multipassus((size_t)4, PVI_RK4) == 0){\
+      pvi_inclinatio[0] = PVI__MULTIPASSUS(0);\
+      pvi_inclinatio[1] = PVI__MULTIPASSUS(1);\
+      pvi_inclinatio[2] = PVI__MULTIPASSUS(2);\
+      pvi_Xaux = PVI__MULTIPASSUS(3);\
+      /* Coeficiente de Adans-Bashforth */\
+      pvi_hh[0] = pvi_h * 5.0 / 12.0;\
+      pvi_hh[1] = pvi_h * (-4.0 / 3.0);\
+      pvi_hh[2] = pvi_h * 23.0 / 12.0;\
+      /* Coeficiente de Adans-Moulton */\
+      pvi_hhh[0] = pvi_h * (-1.0 / 12.0);\
+      pvi_hhh[1] = pvi_h * (8.0 / 12.0);\
+      pvi_hhh[2] = pvi_h * (5.0 / 12.0);\
+\
+      pvi_finalis1 = pvi_finalis;\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
 \
-   while(t < pvi_finalis){\
-      /* ----- Preditor ----- */ \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_Xaux[pvi_index] = (X)[pvi_index] + \
-            pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
-      }\
-      t += pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_inclinatio[0][pvi_index] = pvi_inclinatio[1][pvi_index];\
-         pvi_inclinatio[1][pvi_index] = pvi_inclinatio[2][pvi_index];\
-      }\
-      /* ----- Corretor ----- */ \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         (X)[pvi_index] += \
-            pvi_inclinatio[2][pvi_index] * pvi_hhh[2] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hhh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hhh[0];\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+      pvi_finalis = pvi_finalis1;\
+\
+      while(t < pvi_finalis){\
+         /* ----- Preditor ----- */ \
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            pvi_Xaux[pvi_index] = (X)[pvi_index] + \
+               pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
+         }\
+         t += pvi_h;\
+         pvi__roda(pvi_inclinatio, (size_t)3);\
+         /* ----- Corretor ----- */ \
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            (X)[pvi_index] += \
+               pvi_inclinatio[2][pvi_index] * pvi_hhh[2] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hhh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hhh[0];\
+         }\
+         PVI_FAC_ALIQUID();\
       }\
-      PVI_FAC_ALIQUID();\
    }\
-   free(pvi_inclinatio[0]);\
-   free(pvi_inclinatio[1]);\
-   free(pvi_inclinatio[2]);\
-   free(pvi_Xaux);\
 }
 
 #define PVI_INTEGRATOR_ABM4(t, X, X_punctum) \
@@ -684,74 +2451,67 @@ static double pvi_h = 0.25, pvi_finalis = 1.0;
    PVI_CORPUS \
       *pvi_inclinatio[4] = { NULL, NULL, NULL, NULL }, *pvi_Xaux;\
 \
-   pvi_inclinatio[0] = PVI_ALLOCARE();\
-   pvi_inclinatio[1] = PVI_ALLOCARE();\
-   pvi_inclinatio[2] = PVI_ALLOCARE();\
-   pvi_inclinatio[3] = PVI_ALLOCARE();\
-   pvi_Xaux = PVI_ALLOCARE();\
-   /* Coeficiente de Adans-Bashforth */\
-   pvi_hh[0] = pvi_h * (-9.0 / 24.0);\
-   pvi_hh[1] = pvi_h * (37.0 / 24.0);\
-   pvi_hh[2] = pvi_h * (-59.0 / 24.0);\
-   pvi_hh[3] = pvi_h * (55.0 / 24.0);\
-   /* Coeficiente de Adans-Moulton */\
-   pvi_hhh[0] = pvi_h * (1.0 / 24.0);\
-   pvi_hhh[1] = pvi_h * (-5.0 / 24.0);\
-   pvi_hhh[2] = pvi_h * (19.0 / 24.0);\
-   pvi_hhh[3] = pvi_h * (9.0 / 24.0);\
-\
-   pvi_finalis1 = pvi_finalis;\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-   pvi_finalis = pvi_finalis1;\
+   if(pvi__multipassus((size_t)5, PVI_RK4) == 0){\
+      pvi_inclinatio[0] = PVI__MULTIPASSUS(0);\
+      pvi_inclinatio[1] = PVI__MULTIPASSUS(1);\
+      pvi_inclinatio[2] = PVI__MULTIPASSUS(2);\
+      pvi_inclinatio[3] = PVI__MULTIPASSUS(3);\
+      pvi_Xaux = PVI__MULTIPASSUS(4);\
+      /* Coeficiente de Adans-Bashforth */\
+      pvi_hh[0] = pvi_h * (-9.0 / 24.0);\
+      pvi_hh[1] = pvi_h * (37.0 / 24.0);\
+      pvi_hh[2] = pvi_h * (-59.0 / 24.0);\
+      pvi_hh[3] = pvi_h * (55.0 / 24.0);\
+      /* Coeficiente de Adans-Moulton */\
+      pvi_hhh[0] = pvi_h * (1.0 / 24.0);\
+      pvi_hhh[1] = pvi_h * (-5.0 / 24.0);\
+      pvi_hhh[2] = pvi_h * (19.0 / 24.0);\
+      pvi_hhh[3] = pvi_h * (9.0 / 24.0);\
+\
+      pvi_finalis1 = pvi_finalis;\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
 \
-   while(t < pvi_finalis){\
-      /* ----- Preditor ----- */ \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, X);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_Xaux[pvi_index] = (X)[pvi_index] + \
-            pvi_inclinatio[3][pvi_index] * pvi_hh[3] + \
-            pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
-      }\
-      t += pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_inclinatio[0][pvi_index] = pvi_inclinatio[1][pvi_index];\
-         pvi_inclinatio[1][pvi_index] = pvi_inclinatio[2][pvi_index];\
-         pvi_inclinatio[2][pvi_index] = pvi_inclinatio[3][pvi_index];\
-      }\
-      /* ----- Corretor ----- */ \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         (X)[pvi_index] += \
-            pvi_inclinatio[3][pvi_index] * pvi_hhh[3] + \
-            pvi_inclinatio[2][pvi_index] * pvi_hhh[2] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hhh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hhh[0];\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+      pvi_finalis = pvi_finalis1;\
+\
+      while(t < pvi_finalis){\
+         /* ----- Preditor ----- */ \
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, X);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            pvi_Xaux[pvi_index] = (X)[pvi_index] + \
+               pvi_inclinatio[3][pvi_index] * pvi_hh[3] + \
+               pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
+         }\
+         t += pvi_h;\
+         pvi__roda(pvi_inclinatio, (size_t)4);\
+         /* ----- Corretor ----- */ \
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            (X)[pvi_index] += \
+               pvi_inclinatio[3][pvi_index] * pvi_hhh[3] + \
+               pvi_inclinatio[2][pvi_index] * pvi_hhh[2] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hhh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hhh[0];\
+         }\
+         PVI_FAC_ALIQUID();\
       }\
-      PVI_FAC_ALIQUID();\
    }\
-   free(pvi_inclinatio[0]);\
-   free(pvi_inclinatio[1]);\
-   free(pvi_inclinatio[2]);\
-   free(pvi_inclinatio[3]);\
-   free(pvi_Xaux);\
 }
 
 #define PVI_INTEGRATOR_ABM5(t, X, X_punctum) \
@@ -761,86 +2521,77 @@ static double pvi_h = 0.25, pvi_finalis = 1.0;
    PVI_CORPUS \
       *pvi_inclinatio[5] = { NULL, NULL, NULL, NULL, NULL }, *pvi_Xaux;\
 \
-   pvi_inclinatio[0] = PVI_ALLOCARE();\
-   pvi_inclinatio[1] = PVI_ALLOCARE();\
-   pvi_inclinatio[2] = PVI_ALLOCARE();\
-   pvi_inclinatio[3] = PVI_ALLOCARE();\
-   pvi_inclinatio[4] = PVI_ALLOCARE();\
-   pvi_Xaux = PVI_ALLOCARE();\
-   /* Coeficiente de Adans-Bashforth */\
-   pvi_hh[0] = pvi_h * 251.0 / 720.0;\
-   pvi_hh[1] = pvi_h * (-1274.0 / 720.0);\
-   pvi_hh[2] = pvi_h * 2616.0 / 720.0;\
-   pvi_hh[3] = pvi_h * (-2774.0 / 720.0);\
-   pvi_hh[4] = pvi_h * 1901.0 / 720.0;\
-   /* Coeficiente de Adans-Moulton */\
-   pvi_hhh[0] = pvi_h * (-19.0 / 720.0);\
-   pvi_hhh[1] = pvi_h * (106.0 / 720.0);\
-   pvi_hhh[2] = pvi_h * (-264.0 / 720.0);\
-   pvi_hhh[3] = pvi_h * (646.0 / 720.0);\
-   pvi_hhh[4] = pvi_h * 251.0 / 720.0;\
-\
-   pvi_finalis1 = pvi_finalis;\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-   pvi_finalis = pvi_finalis1;\
+   if(pvi__multipassus((size_t)6, PVI_RK4) == 0){\
+      pvi_inclinatio[0] = PVI__MULTIPASSUS(0);\
+      pvi_inclinatio[1] = PVI__MULTIPASSUS(1);\
+      pvi_inclinatio[2] = PVI__MULTIPASSUS(2);\
+      pvi_inclinatio[3] = PVI__MULTIPASSUS(3);\
+      pvi_inclinatio[4] = PVI__MULTIPASSUS(4);\
+      pvi_Xaux = PVI__MULTIPASSUS(5);\
+      /* Coeficiente de Adans-Bashforth */\
+      pvi_hh[0] = pvi_h * 251.0 / 720.0;\
+      pvi_hh[1] = pvi_h * (-1274.0 / 720.0);\
+      pvi_hh[2] = pvi_h * 2616.0 / 720.0;\
+      pvi_hh[3] = pvi_h * (-2774.0 / 720.0);\
+      pvi_hh[4] = pvi_h * 1901.0 / 720.0;\
+      /* Coeficiente de Adans-Moulton */\
+      pvi_hhh[0] = pvi_h * (-19.0 / 720.0);\
+      pvi_hhh[1] = pvi_h * (106.0 / 720.0);\
+      pvi_hhh[2] = pvi_h * (-264.0 / 720.0);\
+      pvi_hhh[3] = pvi_h * (646.0 / 720.0);\
+      pvi_hhh[4] = pvi_h * 251.0 / 720.0;\
+\
+      pvi_finalis1 = pvi_finalis;\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
 \
-   while(t < pvi_finalis){\
-      /* ----- Preditor ----- */ \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[4][pvi_index] = X_punctum(pvi_index, t, X);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_Xaux[pvi_index] = (X)[pvi_index] + \
-            pvi_inclinatio[4][pvi_index] * pvi_hh[4] + \
-            pvi_inclinatio[3][pvi_index] * pvi_hh[3] + \
-            pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
-      }\
-      t += pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_inclinatio[0][pvi_index] = pvi_inclinatio[1][pvi_index];\
-         pvi_inclinatio[1][pvi_index] = pvi_inclinatio[2][pvi_index];\
-         pvi_inclinatio[2][pvi_index] = pvi_inclinatio[3][pvi_index];\
-         pvi_inclinatio[3][pvi_index] = pvi_inclinatio[4][pvi_index];\
-      }\
-      /* ----- Corretor ----- */ \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[4][pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         (X)[pvi_index] += \
-            pvi_inclinatio[4][pvi_index] * pvi_hhh[4] + \
-            pvi_inclinatio[3][pvi_index] * pvi_hhh[3] + \
-            pvi_inclinatio[2][pvi_index] * pvi_hhh[2] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hhh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hhh[0];\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+      pvi_finalis = pvi_finalis1;\
+\
+      while(t < pvi_finalis){\
+         /* ----- Preditor ----- */ \
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[4][pvi_index] = X_punctum(pvi_index, t, X);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            pvi_Xaux[pvi_index] = (X)[pvi_index] + \
+               pvi_inclinatio[4][pvi_index] * pvi_hh[4] + \
+               pvi_inclinatio[3][pvi_index] * pvi_hh[3] + \
+               pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
+         }\
+         t += pvi_h;\
+         pvi__roda(pvi_inclinatio, (size_t)5);\
+         /* ----- Corretor ----- */ \
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[4][pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            (X)[pvi_index] += \
+               pvi_inclinatio[4][pvi_index] * pvi_hhh[4] + \
+               pvi_inclinatio[3][pvi_index] * pvi_hhh[3] + \
+               pvi_inclinatio[2][pvi_index] * pvi_hhh[2] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hhh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hhh[0];\
+         }\
+         PVI_FAC_ALIQUID();\
       }\
-      PVI_FAC_ALIQUID();\
    }\
-   free(pvi_inclinatio[0]);\
-   free(pvi_inclinatio[1]);\
-   free(pvi_inclinatio[2]);\
-   free(pvi_inclinatio[3]);\
-   free(pvi_inclinatio[4]);\
-   free(pvi_Xaux);\
 }
 
 #define PVI_INTEGRATOR_ABM10(t, X, X_punctum) \
@@ -852,243 +2603,263 @@ static double pvi_h = 0.25, pvi_finalis = 1.0;
       NULL, NULL, NULL, NULL, NULL, \
       NULL, NULL, NULL, NULL, NULL }, *pvi_Xaux;\
 \
-   pvi_inclinatio[0] = PVI_ALLOCARE();\
-   pvi_inclinatio[1] = PVI_ALLOCARE();\
-   pvi_inclinatio[2] = PVI_ALLOCARE();\
-   pvi_inclinatio[3] = PVI_ALLOCARE();\
-   pvi_inclinatio[4] = PVI_ALLOCARE();\
-   pvi_inclinatio[5] = PVI_ALLOCARE();\
-   pvi_inclinatio[6] = PVI_ALLOCARE();\
-   pvi_inclinatio[7] = PVI_ALLOCARE();\
-   pvi_inclinatio[8] = PVI_ALLOCARE();\
-   pvi_inclinatio[9] = PVI_ALLOCARE();\
-   pvi_Xaux = PVI_ALLOCARE();\
-   /* Coeficiente de Adans-Bashforth */\
-   pvi_hh[0] = pvi_h * (-2082753.0 / 7257600.0);\
-   pvi_hh[1] = pvi_h * (20884811.0 / 7257600.0);\
-   pvi_hh[2] = pvi_h * (-94307320.0 / 7257600.0);\
-   pvi_hh[3] = pvi_h * (252618224.0 / 7257600.0);\
-   pvi_hh[4] = pvi_h * (-444772162.0 / 7257600.0);\
-   pvi_hh[5] = pvi_h * (538363838.0 / 7257600.0);\
-   pvi_hh[6] = pvi_h * (-454661776.0 / 7257600.0);\
-   pvi_hh[7] = pvi_h * (265932680.0 / 7257600.0);\
-   pvi_hh[8] = pvi_h * (-104995189.0 / 7257600.0);\
-   pvi_hh[9] = pvi_h * (30277247.0 / 7257600.0);\
-   /* Coeficiente de Adans-Moulton */\
-   pvi_hhh[0] = pvi_h * (57281.0 / 7257600.0);\
-   pvi_hhh[1] = pvi_h * (-583435.0 / 7257600.0);\
-   pvi_hhh[2] = pvi_h * (2687864.0 / 7257600.0);\
-   pvi_hhh[3] = pvi_h * (-7394032.0 / 7257600.0);\
-   pvi_hhh[4] = pvi_h * (13510082.0 / 7257600.0);\
-   pvi_hhh[5] = pvi_h * (-17283646.0 / 7257600.0);\
-   pvi_hhh[6] = pvi_h * (16002320.0 / 7257600.0);\
-   pvi_hhh[7] = pvi_h * (-11271304.0 / 7257600.0);\
-   pvi_hhh[8] = pvi_h * (9449717.0 / 7257600.0);\
-   pvi_hhh[9] = pvi_h * (2082753.0 / 7257600.0);\
-\
-   pvi_finalis1 = pvi_finalis;\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[4][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[5][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[6][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[7][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-\
-   for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-      pvi_inclinatio[8][pvi_index] = X_punctum(pvi_index, t, X);\
-   pvi_finalis = t + pvi_h;\
-   PVI_INTEGRATOR_RK4(t, X, X_punctum);\
-   pvi_finalis = pvi_finalis1;\
+   if(pvi__multipassus((size_t)11, PVI_RK4) == 0){\
+      pvi_inclinatio[0] = PVI__MULTIPASSUS(0);\
+      pvi_inclinatio[1] = PVI__MULTIPASSUS(1);\
+      pvi_inclinatio[2] = PVI__MULTIPASSUS(2);\
+      pvi_inclinatio[3] = PVI__MULTIPASSUS(3);\
+      pvi_inclinatio[4] = PVI__MULTIPASSUS(4);\
+      pvi_inclinatio[5] = PVI__MULTIPASSUS(5);\
+      pvi_inclinatio[6] = PVI__MULTIPASSUS(6);\
+      pvi_inclinatio[7] = PVI__MULTIPASSUS(7);\
+      pvi_inclinatio[8] = PVI__MULTIPASSUS(8);\
+      pvi_inclinatio[9] = PVI__MULTIPASSUS(9);\
+      pvi_Xaux = PVI__MULTIPASSUS(10);\
+      /* Coeficiente de Adans-Bashforth */\
+      pvi_hh[0] = pvi_h * (-2082753.0 / 7257600.0);\
+      pvi_hh[1] = pvi_h * (20884811.0 / 7257600.0);\
+      pvi_hh[2] = pvi_h * (-94307320.0 / 7257600.0);\
+      pvi_hh[3] = pvi_h * (252618224.0 / 7257600.0);\
+      pvi_hh[4] = pvi_h * (-444772162.0 / 7257600.0);\
+      pvi_hh[5] = pvi_h * (538363838.0 / 7257600.0);\
+      pvi_hh[6] = pvi_h * (-454661776.0 / 7257600.0);\
+      pvi_hh[7] = pvi_h * (265932680.0 / 7257600.0);\
+      pvi_hh[8] = pvi_h * (-104995189.0 / 7257600.0);\
+      pvi_hh[9] = pvi_h * (30277247.0 / 7257600.0);\
+      /* Coeficiente de Adans-Moulton */\
+      pvi_hhh[0] = pvi_h * (57281.0 / 7257600.0);\
+      pvi_hhh[1] = pvi_h * (-583435.0 / 7257600.0);\
+      pvi_hhh[2] = pvi_h * (2687864.0 / 7257600.0);\
+      pvi_hhh[3] = pvi_h * (-7394032.0 / 7257600.0);\
+      pvi_hhh[4] = pvi_h * (13510082.0 / 7257600.0);\
+      pvi_hhh[5] = pvi_h * (-17283646.0 / 7257600.0);\
+      pvi_hhh[6] = pvi_h * (16002320.0 / 7257600.0);\
+      pvi_hhh[7] = pvi_h * (-11271304.0 / 7257600.0);\
+      pvi_hhh[8] = pvi_h * (9449717.0 / 7257600.0);\
+      pvi_hhh[9] = pvi_h * (2082753.0 / 7257600.0);\
+\
+      pvi_finalis1 = pvi_finalis;\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[0][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[1][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
 \
-   while(t < pvi_finalis){\
-      /* ----- Preditor ----- */ \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[9][pvi_index] = X_punctum(pvi_index, t, X);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_Xaux[pvi_index] = (X)[pvi_index] + \
-            pvi_inclinatio[9][pvi_index] * pvi_hh[9] + \
-            pvi_inclinatio[8][pvi_index] * pvi_hh[8] + \
-            pvi_inclinatio[7][pvi_index] * pvi_hh[7] + \
-            pvi_inclinatio[6][pvi_index] * pvi_hh[6] + \
-            pvi_inclinatio[5][pvi_index] * pvi_hh[5] + \
-            pvi_inclinatio[4][pvi_index] * pvi_hh[4] + \
-            pvi_inclinatio[3][pvi_index] * pvi_hh[3] + \
-            pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
-      }\
-      t += pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         pvi_inclinatio[0][pvi_index] = pvi_inclinatio[1][pvi_index];\
-         pvi_inclinatio[1][pvi_index] = pvi_inclinatio[2][pvi_index];\
-         pvi_inclinatio[2][pvi_index] = pvi_inclinatio[3][pvi_index];\
-         pvi_inclinatio[3][pvi_index] = pvi_inclinatio[4][pvi_index];\
-         pvi_inclinatio[4][pvi_index] = pvi_inclinatio[5][pvi_index];\
-         pvi_inclinatio[5][pvi_index] = pvi_inclinatio[6][pvi_index];\
-         pvi_inclinatio[6][pvi_index] = pvi_inclinatio[7][pvi_index];\
-         pvi_inclinatio[7][pvi_index] = pvi_inclinatio[8][pvi_index];\
-         pvi_inclinatio[8][pvi_index] = pvi_inclinatio[9][pvi_index];\
-      }\
-      /* ----- Corretor ----- */ \
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         pvi_inclinatio[9][pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
-         (X)[pvi_index] += \
-            pvi_inclinatio[9][pvi_index] * pvi_hhh[9] + \
-            pvi_inclinatio[8][pvi_index] * pvi_hhh[8] + \
-            pvi_inclinatio[7][pvi_index] * pvi_hhh[7] + \
-            pvi_inclinatio[6][pvi_index] * pvi_hhh[6] + \
-            pvi_inclinatio[5][pvi_index] * pvi_hhh[5] + \
-            pvi_inclinatio[4][pvi_index] * pvi_hhh[4] + \
-            pvi_inclinatio[3][pvi_index] * pvi_hhh[3] + \
-            pvi_inclinatio[2][pvi_index] * pvi_hhh[2] + \
-            pvi_inclinatio[1][pvi_index] * pvi_hhh[1] + \
-            pvi_inclinatio[0][pvi_index] * pvi_hhh[0];\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[2][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[3][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[4][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[5][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[6][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[7][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+\
+      PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+         pvi_inclinatio[8][pvi_index] = X_punctum(pvi_index, t, X);\
+      pvi_finalis = t + pvi_h;\
+      PVI_INTEGRATOR_RK4(t, X, X_punctum);\
+      pvi_finalis = pvi_finalis1;\
+\
+      while(t < pvi_finalis){\
+         /* ----- Preditor ----- */ \
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[9][pvi_index] = X_punctum(pvi_index, t, X);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            pvi_Xaux[pvi_index] = (X)[pvi_index] + \
+               pvi_inclinatio[9][pvi_index] * pvi_hh[9] + \
+               pvi_inclinatio[8][pvi_index] * pvi_hh[8] + \
+               pvi_inclinatio[7][pvi_index] * pvi_hh[7] + \
+               pvi_inclinatio[6][pvi_index] * pvi_hh[6] + \
+               pvi_inclinatio[5][pvi_index] * pvi_hh[5] + \
+               pvi_inclinatio[4][pvi_index] * pvi_hh[4] + \
+               pvi_inclinatio[3][pvi_index] * pvi_hh[3] + \
+               pvi_inclinatio[2][pvi_index] * pvi_hh[2] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hh[0];\
+         }\
+         t += pvi_h;\
+         pvi__roda(pvi_inclinatio, (size_t)10);\
+         /* ----- Corretor ----- */ \
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
+            pvi_inclinatio[9][pvi_index] = X_punctum(pvi_index, t, pvi_Xaux);\
+         PVI_PARALLELE for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index){\
+            (X)[pvi_index] += \
+               pvi_inclinatio[9][pvi_index] * pvi_hhh[9] + \
+               pvi_inclinatio[8][pvi_index] * pvi_hhh[8] + \
+               pvi_inclinatio[7][pvi_index] * pvi_hhh[7] + \
+               pvi_inclinatio[6][pvi_index] * pvi_hhh[6] + \
+               pvi_inclinatio[5][pvi_index] * pvi_hhh[5] + \
+               pvi_inclinatio[4][pvi_index] * pvi_hhh[4] + \
+               pvi_inclinatio[3][pvi_index] * pvi_hhh[3] + \
+               pvi_inclinatio[2][pvi_index] * pvi_hhh[2] + \
+               pvi_inclinatio[1][pvi_index] * pvi_hhh[1] + \
+               pvi_inclinatio[0][pvi_index] * pvi_hhh[0];\
+         }\
+         PVI_FAC_ALIQUID();\
       }\
-      PVI_FAC_ALIQUID();\
    }\
-   free(pvi_inclinatio[0]);\
-   free(pvi_inclinatio[1]);\
-   free(pvi_inclinatio[2]);\
-   free(pvi_inclinatio[3]);\
-   free(pvi_inclinatio[4]);\
-   free(pvi_inclinatio[5]);\
-   free(pvi_inclinatio[6]);\
-   free(pvi_inclinatio[7]);\
-   free(pvi_inclinatio[8]);\
-   free(pvi_inclinatio[9]);\
-   free(pvi_Xaux);\
 }
 
+/* Embedded pair of Dormand and Prince with step control: pvi_h is only the
+   first trial step and pvi_tolerantia both the absolute and the relative
+   tolerance. */
+#define PVI_INTEGRATOR_DOPRI5(t, X, X_punctum) \
+   PVI__CAMPUS(t, X, X_punctum, PVI_DOPRI5)
+
+/* Variable step and order: pvi_h is only the first trial step and
+   pvi_tolerantia both the absolute and the relative tolerance. */
+#define PVI_INTEGRATOR_ABM_VARIABILIS(t, X, X_punctum) \
+   PVI__CAMPUS(t, X, X_punctum, PVI_ABM_VARIABILIS)
+
+/* Krylov exponential for a linear and autonomous field, X_punctum(n, t, X)
+   being the component n of D X: pvi_h is only the first trial step and
+   pvi_tolerantia both the absolute and the relative tolerance. D is taken
+   as a general matrix (Arnoldi). */
+#define PVI_INTEGRATOR_KRYLOV(t, X, X_punctum) \
+   PVI__CAMPUS(t, X, X_punctum, PVI_KRYLOV)
+
 /* ------------------------------------
    Metodos simpleticos
 ----------------------------------- */
 
 #define PVI_INTEGRATOR_EULER_S(t, X, Y, X_punctum, Y_punctum) \
-{\
-   size_t pvi_index;\
-   while(t < pvi_finalis){\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (Y)[pvi_index] += Y_punctum(pvi_index, X) * pvi_h;\
-      t += pvi_h;\
-      PVI_FAC_ALIQUID();\
-   }\
-}
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_EULER_S)
 
 #define PVI_INTEGRATOR_VERLET(t, X, Y, X_punctum, Y_punctum) \
-{\
-   size_t pvi_index;\
-   double pvi_hh; \
-   pvi_hh = pvi_h * 0.5;\
-\
-   while(t < pvi_finalis){\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (Y)[pvi_index] += Y_punctum(pvi_index, X) * pvi_h;\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh;\
-      t += pvi_h;\
-      PVI_FAC_ALIQUID();\
-   }\
-}
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_VERLET)
 
 #define PVI_INTEGRATOR_RUTH3(t, X, Y, X_punctum, Y_punctum) \
-{\
-   size_t pvi_index;\
-   double pvi_hh[6]; \
-   pvi_hh[0] = pvi_h * (7.0 / 24.0);\
-   pvi_hh[1] = pvi_h * (2.0 / 3.0);\
-   pvi_hh[2] = pvi_h * 0.75;\
-   pvi_hh[3] = pvi_h * (-2.0 / 3.0);\
-   pvi_hh[4] = pvi_h * (-1.0 / 24.0);\
-   pvi_hh[5] = pvi_h;\
-\
-   while(t < pvi_finalis){\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (Y)[pvi_index] += Y_punctum(pvi_index, X) * pvi_hh[0];\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh[1];\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (Y)[pvi_index] += Y_punctum(pvi_index, X) * pvi_hh[2];\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh[3];\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (Y)[pvi_index] += Y_punctum(pvi_index, X) * pvi_hh[4];\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh[5];\
-      t += pvi_h;\
-      PVI_FAC_ALIQUID();\
-   }\
-}
-
-#define PVI_RAIZ_CUBICA_2 1.25992104989
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_RUTH3)
 
 #define PVI_INTEGRATOR_RUTH4(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_RUTH4)
+
+#define PVI_INTEGRATOR_YOSHIDA6(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_YOSHIDA6)
+
+#define PVI_INTEGRATOR_YOSHIDA8(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_YOSHIDA8)
+
+#define PVI_INTEGRATOR_BLANES_MOAN4(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_BLANES_MOAN4)
+
+#define PVI_INTEGRATOR_BLANES_MOAN6(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_BLANES_MOAN6)
+
+/* Only of order 4 and 6 when X_punctum(n, Y) is linear in Y. */
+#define PVI_INTEGRATOR_BLANES_MOAN_RKN4(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_BLANES_MOAN_RKN4)
+
+#define PVI_INTEGRATOR_BLANES_MOAN_RKN6(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_BLANES_MOAN_RKN6)
+
+#define PVI_INTEGRATOR_SABA2(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_SABA2)
+
+#define PVI_INTEGRATOR_SABA3(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_SABA3)
+
+#define PVI_INTEGRATOR_SABA4(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_SABA4)
+
+#define PVI_INTEGRATOR_SBAB2(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_SBAB2)
+
+#define PVI_INTEGRATOR_SBAB3(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_SBAB3)
+
+#define PVI_INTEGRATOR_SBAB4(t, X, Y, X_punctum, Y_punctum) \
+   PVI__GRADUS(t, X, Y, X_punctum, Y_punctum, PVI_SBAB4)
+
+/* Same composition as PVI_INTEGRATOR_RUTH4, but the seven sub-stages are
+   carried out in a single skewed (wavefront) sweep over the indices instead
+   of seven full sweeps, so each element is brought from memory once per step.
+   Only valid when X_punctum(n, Y) depends on Y[n] alone and Y_punctum(n, X)
+   on X[n-1], X[n] and X[n+1] alone, as in a nearest-neighbour chain.
+   At position j of the sweep the sub-stage k acts on the index j - k, hence
+   every sub-stage sees its neighbours exactly as the seven sweeps would and
+   the trajectory is the same as the one of PVI_INTEGRATOR_RUTH4. */
+#define PVI_INTEGRATOR_RUTH4_FUSUS(t, X, Y, X_punctum, Y_punctum) \
 {\
-   size_t pvi_index;\
+   size_t pvi_index, pvi_unda;\
    double pvi_hh[4]; \
-   pvi_hh[0] = pvi_h * (0.5 / (2.0 - PVI_RAIZ_CUBICA_2));\
-   pvi_hh[1] = pvi_h * (1.0 / (2.0 - PVI_RAIZ_CUBICA_2));\
-   pvi_hh[2] = pvi_h * ((1.0 - PVI_RAIZ_CUBICA_2) * 0.5 / (2.0 - PVI_RAIZ_CUBICA_2));\
-   pvi_hh[3] = pvi_h * (-PVI_RAIZ_CUBICA_2 / (2.0 - PVI_RAIZ_CUBICA_2));\
+   for(pvi_unda = (size_t)0; pvi_unda < (size_t)4; ++pvi_unda)\
+      pvi_hh[pvi_unda] = pvi_h * pvi__ruth4[pvi_unda];\
 \
    while(t < pvi_finalis){\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh[0];\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (Y)[pvi_index] += Y_punctum(pvi_index, X) * pvi_hh[1];\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh[2];\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (Y)[pvi_index] += Y_punctum(pvi_index, X) * pvi_hh[3];\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh[2];\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (Y)[pvi_index] += Y_punctum(pvi_index, X) * pvi_hh[1];\
-      for(pvi_index = (size_t)0; pvi_index < pvi_dimensio; ++pvi_index)\
-         (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh[0];\
+      for(pvi_unda = (size_t)0; pvi_unda < pvi_dimensio + (size_t)6; ++pvi_unda){\
+         /* unsigned wrap-around also discards the indices below zero */\
+         if((pvi_index = pvi_unda) < pvi_dimensio)\
+            (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh[0];\
+         if((pvi_index = pvi_unda - (size_t)1) < pvi_dimensio)\
+            (Y)[pvi_index] += Y_punctum(pvi_index, X) * pvi_hh[1];\
+         if((pvi_index = pvi_unda - (size_t)2) < pvi_dimensio)\
+            (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh[2];\
+         if((pvi_index = pvi_unda - (size_t)3) < pvi_dimensio)\
+            (Y)[pvi_index] += Y_punctum(pvi_index, X) * pvi_hh[3];\
+         if((pvi_index = pvi_unda - (size_t)4) < pvi_dimensio)\
+            (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh[2];\
+         if((pvi_index = pvi_unda - (size_t)5) < pvi_dimensio)\
+            (Y)[pvi_index] += Y_punctum(pvi_index, X) * pvi_hh[1];\
+         if((pvi_index = pvi_unda - (size_t)6) < pvi_dimensio)\
+            (X)[pvi_index] += X_punctum(pvi_index, Y) * pvi_hh[0];\
+      }\
       t += pvi_h;\
       PVI_FAC_ALIQUID();\
    }\
 }
 
+/* ------------------------------------
+   Metodos simpleticos em blocos
+----------------------------------- */
+
+/* In the block variants the vector field is not given element by element,
+   instead X_gradus(a, b, c, X, Y, data) must perform
+      X[n] += c * X_punctum(n, Y)   for a <= n < b
+   (and likewise Y_gradus), so that the callback can process a whole range
+   of indices with vector instructions. These are the gradus_X and gradus_Y
+   callbacks of the context, the macros hand over data = NULL. PVI_BLOCUS
+   is the number of indices handed over at once by
+   PVI_INTEGRATOR_RUTH4_FUSUS_BLOCUS. */
+#ifndef PVI_BLOCUS
+#define PVI_BLOCUS ((size_t)64)
+#endif
+
+#define PVI_INTEGRATOR_RUTH4_BLOCUS(t, X, Y, X_gradus, Y_gradus) \
+   PVI__BLOCUS(t, X, Y, X_gradus, Y_gradus, PVI_RUTH4)
+
+/* Block version of PVI_INTEGRATOR_RUTH4_FUSUS, under the same hypotheses,
+   PVI_BLOCUS must not be smaller than the reach of the stencil in Y_gradus
+   (see pvi__fusus). */
+#define PVI_INTEGRATOR_RUTH4_FUSUS_BLOCUS(t, X, Y, X_gradus, Y_gradus) \
+   PVI__BLOCUS(t, X, Y, X_gradus, Y_gradus, PVI_RUTH4_FUSUS)
+
 #ifdef __cplusplus
 }
 #endif
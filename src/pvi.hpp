@@ -0,0 +1,189 @@
+/* *****************************************************************************
+   C++ front end of pvi.h, with the vector field given as a functor.
+   *****************************************************************************
+   E-mail: ismlxd@gmail.com
+   Site: https://ismdamiao.github.io/
+   *****************************************************************************
+   Copyright (C) 2025 I.F.F. dos Santos
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the “Software”), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+***************************************************************************** */
+#ifndef PVI_HPP
+#define PVI_HPP 1
+
+#include <cstddef>
+#include <utility>
+#include "pvi.h"
+
+/* The integrators of pvi.hpp own a pvi_contextus and a functor of the
+   field, in the block forms of pvi.h without the pointer `data`:
+   * campus(a, b, t, X, F), which writes F[n] = f(n, t, X), for
+     PVI_EULER, PVI_RK2, PVI_RK4, PVI_DOPRI5, PVI_ABM_VARIABILIS and
+     PVI_KRYLOV;
+   * gradus_X(a, b, c, X, Y) and gradus_Y(a, b, c, Y, X), which perform
+     X[n] += c * punctum_X(n, Y) and Y[n] += c * punctum_Y(n, X), for the
+     symplectic methods;
+   all of them for a <= n < b. Each step goes through pvi_progredere_campus
+   or pvi_progredere_gradus with a trampoline instantiated for the type of
+   the functor, so the sweeps of the method, the trampoline and the body of
+   the functor are compiled together at the call site, and the functor is
+   inlined and vectorised as a hand-written loop would be. For example
+
+      auto oscillator = pvi::crea(PVI_RK4, N, h,
+         [&](std::size_t a, std::size_t b, double, const double *X,
+            double *F){
+            for(std::size_t n = a; n < b; ++n) F[n] = -omega[n] * X[n];
+         });
+      oscillator.contextus()->x = X;
+      oscillator.curre(finalis);
+
+   contextus() gives the pvi_contextus itself, for the initial time, the
+   state, the tolerances, blocus, fusus and the counters, and is NULL when
+   pvi_crea failed. Its `data` and block callbacks belong to the
+   integrator, which therefore cannot be copied, only moved. */
+namespace pvi {
+
+/* What is common to both integrators, Ipse being the derived class. */
+template<class Ipse>
+class fundamentum {
+public:
+   fundamentum(const fundamentum&) = delete;
+   fundamentum &operator=(const fundamentum&) = delete;
+
+   pvi_contextus *contextus() const { return c; }
+   explicit operator bool() const { return c != nullptr; }
+
+   /* As pvi_curre, with aliquid(integrator) after each step. */
+   template<class Aliquid>
+   int curre(double finalis, Aliquid aliquid){
+      Ipse &ipse = static_cast<Ipse&>(*this);
+      int status;
+
+      if(c == nullptr) return -1;
+      c->terminus = finalis;
+      while(c->tempus < finalis){
+         if((status = ipse.progredere()) != 0) return status;
+         if((status = aliquid(ipse)) != 0) return status;
+      }
+      return 0;
+   }
+   int curre(double finalis){
+      return curre(finalis, [](Ipse&){ return 0; });
+   }
+
+   /* As pvi_interpola, Y only for the symplectic methods. */
+   int interpola(double t, PVI_CORPUS *X, PVI_CORPUS *Y = nullptr){
+      return (c == nullptr ? -1 : pvi_interpola(c, t, X, Y));
+   }
+
+protected:
+   pvi_contextus *c;
+
+   explicit fundamentum(pvi_contextus *contextus) : c(contextus) {}
+   fundamentum(fundamentum &&alius) : c(alius.c) { alius.c = nullptr; }
+   ~fundamentum(){ pvi_destrue(c); }
+};
+
+template<class Campus>
+class integrator : public fundamentum<integrator<Campus> > {
+public:
+   Campus campus;
+
+   integrator(int methodus, std::size_t dimensio, double h, Campus f) :
+      fundamentum<integrator>(pvi_crea(methodus, dimensio, h)),
+      campus(std::move(f)) { necte(); }
+   integrator(integrator &&alius) :
+      fundamentum<integrator>(std::move(alius)),
+      campus(std::move(alius.campus)) { necte(); }
+
+   /* As pvi_progredere. */
+   int progredere(){
+      return (this->c == nullptr ? -1 :
+         pvi_progredere_campus(this->c, &integrator::per));
+   }
+
+private:
+   static void per(std::size_t a, std::size_t b, double t,
+      PVI_CORPUS *X, PVI_CORPUS *F, void *data){
+      static_cast<integrator*>(data)->campus(a, b, t, X, F);
+   }
+   /* the context also works with pvi_progredere and pvi_interpola */
+   void necte(){
+      if(this->c == nullptr) return;
+      this->c->campus = &integrator::per;
+      this->c->data = this;
+   }
+};
+
+template<class GradusX, class GradusY>
+class symplecticus : public fundamentum<symplecticus<GradusX, GradusY> > {
+public:
+   GradusX gradus_X;
+   GradusY gradus_Y;
+
+   symplecticus(int methodus, std::size_t dimensio, double h,
+      GradusX gx, GradusY gy) :
+      fundamentum<symplecticus>(pvi_crea(methodus, dimensio, h)),
+      gradus_X(std::move(gx)), gradus_Y(std::move(gy)) { necte(); }
+   symplecticus(symplecticus &&alius) :
+      fundamentum<symplecticus>(std::move(alius)),
+      gradus_X(std::move(alius.gradus_X)),
+      gradus_Y(std::move(alius.gradus_Y)) { necte(); }
+
+   /* As pvi_progredere, with a single wavefront sweep per step when
+      fusus is set. */
+   int progredere(){
+      return (this->c == nullptr ? -1 : pvi_progredere_gradus(this->c,
+         &symplecticus::per_X, &symplecticus::per_Y));
+   }
+
+private:
+   static void per_X(std::size_t a, std::size_t b, double c,
+      PVI_CORPUS *X, PVI_CORPUS *Y, void *data){
+      static_cast<symplecticus*>(data)->gradus_X(a, b, c, X, Y);
+   }
+   static void per_Y(std::size_t a, std::size_t b, double c,
+      PVI_CORPUS *Y, PVI_CORPUS *X, void *data){
+      static_cast<symplecticus*>(data)->gradus_Y(a, b, c, Y, X);
+   }
+   void necte(){
+      if(this->c == nullptr) return;
+      this->c->gradus_X = &symplecticus::per_X;
+      this->c->gradus_Y = &symplecticus::per_Y;
+      this->c->data = this;
+   }
+};
+
+/* Integrators with the type of the functors deduced. */
+template<class Campus>
+integrator<Campus> crea(int methodus, std::size_t dimensio, double h,
+   Campus campus){
+   return integrator<Campus>(methodus, dimensio, h, std::move(campus));
+}
+
+template<class GradusX, class GradusY>
+symplecticus<GradusX, GradusY> crea(int methodus, std::size_t dimensio,
+   double h, GradusX gradus_X, GradusY gradus_Y){
+   return symplecticus<GradusX, GradusY>(methodus, dimensio, h,
+      std::move(gradus_X), std::move(gradus_Y));
+}
+
+} /* namespace pvi */
+
+#endif /* PVI_HPP */
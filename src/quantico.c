@@ -1,9 +1,643 @@
+/* *****************************************************************************
+   Copyright (c) 2025 I.F.F. dos Santos <ismaellxd@gmail.com>
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the “Software”), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+***************************************************************************** */
+#define _POSIX_C_SOURCE 200809L
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
 #include <math.h>
 #include <complex.h>
+#include <unistd.h>
 #include "pvi.h"
+#include "cadeia.h"
+/* ---
+   Contraparte quantica de `classico`: resolve a equacao de Schrodinger
+      i dz_n/dt = e_n z_n + t_n-1 z_n-1 + t_n z_n+1
+   de uma rede 1D de ligacoes fortes com as pontas abertas, onde e_n eh a
+   energia do sitio n e t_n o salto entre os sitios n e n + 1.
+   O passo eh o de Crank-Nicolson,
+      (1 + i h H / 2) z(t + h) = (1 - i h H / 2) z(t),
+   que eh unitario para qualquer h, e a matriz tridiagonal da esquerda eh
+   fatorada uma unica vez, de modo que cada passo custa O(N).
+   Com a opcao -c o propagador eh a expansao de Chebyshev de exp(-i H h),
+   exata ate o arredondamento, e cada intervalo entre escritas eh vencido
+   num unico salto (ver `preparar_chebyshev`). Com a opcao -k o salto
+   eh dado pelo integrador de Krylov de `pvi.h`, com passo adaptativo.
+--- */
+
+#define SIZE_C(x) ((size_t)(x))
+
+typedef double complex complexo;
+
+/* Produto sem a verificacao de infinitos e NaN do Anexo G, que o gcc faz
+   numa chamada de biblioteca a cada multiplicacao. */
+static inline complexo vezes(complexo a, complexo b){
+   return CMPLX(creal(a) * creal(b) - cimag(a) * cimag(b),
+      creal(a) * cimag(b) + cimag(a) * creal(b));
+}
+
+/* As grandezas da rede sao globais nesta unidade de translacao, como em
+   `classico`. A memoria vem de uma unica arena de `pvi.h`, com cada
+   vetor alinhado a uma linha de cache. */
+static size_t N; /* numero de sitios */
+static double *energia_sitio, *salto; /* e_n e t_n, t_N-1 eh ignorado */
+static complexo *z; /* funcao de onda */
+static complexo *lado_direito; /* (1 - i h H / 2) z */
+static complexo *multiplicador, *inverso_pivo; /* fatoracao, ver `fatorar` */
+static complexo *anterior, *atual; /* recorrencia de Chebyshev */
+static pvi_arena memoria;
+
+/* Expansao de Chebyshev: H = centro + raio Hs, com o espectro de Hs em
+   [-1, 1], e os coeficientes da serie de exp(-i H h) ate a ordem. */
+static int chebyshev = 0;
+static double centro_espectro, raio_espectro;
+static complexo *coeficientes;
+static size_t ordem;
+
+/* Com a opcao -k: z vista como 2N doubles, (Re z_n, Im z_n) intercalados,
+   obedece a dx/dt = D x com D = H (x) [[0, 1], [-1, 0]] antissimetrica, e
+   o integrador PVI_KRYLOV usa a recorrencia de Lanczos. O passo da linha
+   de comando eh so o primeiro, o erro local relativo fica abaixo de
+   `tolerancia_krylov`. */
+static int krylov = 0;
+static const double tolerancia_krylov = 1e-12;
+static void aplicar_hamiltoniano(size_t a, size_t b, double t,
+   double *X, double *F, void *data);
+
+/* A conservacao da norma eh conferida a cada `intervalo_monitor` de tempo
+   (opcao -e, por padrao a cada escrita) pelo desvio relativo
+   (|z|^2 - |z0|^2) / |z0|^2, o papel da energia em `classico`. A
+   integracao para quando o desvio passa de `tolerancia` (opcao -t, 0
+   apenas registra), e com a opcao -m o desvio eh registrado num arquivo.
+   O Crank-Nicolson conserva a norma a menos do arredondamento, um desvio
+   grande denuncia uma fatoracao mal condicionada ou uma entrada invalida. */
+static double intervalo_monitor = 0.0;
+static double tolerancia = 1.0e-10;
+static FILE *deriva;
+static double norma_inicial;
+
+/* Com a opcao -o cada escrita eh uma linha com a norma, a energia
+   <z|H|z>, o centro sum n |z_n|^2 / |z|^2, o desvio padrao em torno dele e
+   o numero de participacao |z|^4 / sum |z_n|^4, no lugar da funcao de
+   onda inteira. */
+static int observaveis = 0;
+
+static int preparar_sistema(const char *nome_arquivo);
+static void liberar_sistema(void);
+static void fatorar(double h);
+static void propagar(double h);
+static int preparar_chebyshev(double h);
+static void propagar_chebyshev(void);
+static void medir(double *norma, double *energia, double *centro,
+   double *espalhamento, double *participacao);
+static int escrever(double t);
+static int monitorar(double t);
 
 int main(int argc, char **argv){
+   double h, h_inicial, tempo_final, intervalo = 0.5, t;
+   pvi_contextus *contexto = NULL;
+   unsigned long passos_escrita, passos_monitor, passo;
+   int opcao, status = EXIT_SUCCESS;
+   char *programa = argv[0];
+
+   while((opcao = getopt(argc, argv, "ce:i:km:ot:")) != -1){
+      if(opcao == 'c'){
+         chebyshev = 1;
+         continue;
+      }
+      if(opcao == 'k'){
+         krylov = 1;
+         continue;
+      }
+      if(opcao == 'e'){
+         intervalo_monitor = atof(optarg);
+         continue;
+      }
+      if(opcao == 'i' && (intervalo = atof(optarg)) > 0.0) continue;
+      if(opcao == 'o'){
+         observaveis = 1;
+         continue;
+      }
+      if(opcao == 't'){
+         tolerancia = atof(optarg);
+         continue;
+      }
+      if(opcao == 'm' && deriva == NULL){
+         deriva = fopen(optarg, "w");
+         if(deriva != NULL) continue;
+         fprintf(stderr,
+            "ERRO: N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+            "abrir %s para escrita.\n", optarg);
+      }
+      argc = 0;
+      break;
+   }
+   if(argc > 0){
+      argc -= optind - 1;
+      argv += optind - 1;
+      argv[0] = programa;
+   }
+   if(argc < 2){
+      fputs("ERRO: Argumentos inv" "\xc3\xa1" "lidos.\n", stderr);
+      fprintf(stderr,
+         "%s [-c | -k] [-i intervalo] [-o] [-e intervalo] "
+         "[-t toler" "\xC3\xA2" "ncia] [-m arquivo] [arquivo] "
+         "<tempo final> <passo>\n", programa);
+      fprintf(stderr, "arquivo: uma linha por s" "\xC3\xAD" "tio com a "
+         "energia do s" "\xC3\xAD" "tio, o salto para o seguinte e as "
+         "partes real e imagin" "\xC3\xA1" "ria de z inicial\n");
+      if(deriva != NULL) fclose(deriva);
+      return EXIT_FAILURE;
+   }
+   tempo_final = (argc > 2 ? atof(argv[2]) : 10.0);
+   h = h_inicial = (argc > 3 ? atof(argv[3]) : 0.5);
+   /* a comparacao negada tambem recusa o NaN */
+   if(!(tempo_final > 0.0) || !(h > 0.0)){
+      fputs("ERRO: O tempo final e o passo devem ser positivos.\n", stderr);
+      if(deriva != NULL) fclose(deriva);
+      return EXIT_FAILURE;
+   }
+   if(preparar_sistema(argv[1]) != EXIT_SUCCESS){
+      if(deriva != NULL) fclose(deriva);
+      return EXIT_FAILURE;
+   }
+
+   /* o Crank-Nicolson eh estavel com qualquer passo, h so controla a
+      precisao: ele eh reduzido ate dividir o intervalo entre escritas, que
+      caem entao sobre os passos */
+   passos_escrita = (unsigned long)ceil(intervalo / h - 1e-9);
+   if(passos_escrita == 0UL || chebyshev || krylov) passos_escrita = 1UL;
+   h = intervalo / (double)passos_escrita;
+   if(intervalo_monitor <= 0.0) intervalo_monitor = intervalo;
+   passos_monitor = (unsigned long)(intervalo_monitor / h + 0.5);
+   if(passos_monitor == 0UL) passos_monitor = 1UL;
+   if(krylov){
+      contexto = pvi_crea(PVI_KRYLOV, 2 * N, h_inicial);
+      if(contexto == NULL){
+         fputs(
+            "ERRO: "
+            "N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente mem" "\xC3\xB3" "ria.\n",
+            stderr
+         );
+         liberar_sistema();
+         return EXIT_FAILURE;
+      }
+      contexto->x = (double*)(void*)z;
+      contexto->campus = aplicar_hamiltoniano;
+      contexto->symmetria = -1;
+      contexto->tolerantia_absoluta = 0.0;
+      contexto->tolerantia_relativa = tolerancia_krylov;
+   }else if(chebyshev){
+      if(preparar_chebyshev(h) != EXIT_SUCCESS){
+         liberar_sistema();
+         return EXIT_FAILURE;
+      }
+   }else fatorar(h);
+   if(deriva != NULL){
+      if(chebyshev){
+         fprintf(deriva, "# Chebyshev: espectro em [%.10g, %.10g], "
+            "ordem %zu\n", centro_espectro - raio_espectro,
+            centro_espectro + raio_espectro, ordem);
+      }
+      fprintf(deriva, "# t (|z|^2 - |z0|^2) / |z0|^2\n");
+   }
+   if(observaveis)
+      printf("# t norma energia centro espalhamento participacao\n");
+
+   for(passo = 1UL; ; ++passo){
+      t = (double)passo * h;
+      if(t > tempo_final * (1.0 + 1e-12)) break;
+      if(krylov){
+         if(pvi_curre(contexto, t, NULL) != 0){
+            fprintf(stderr, "O integrador de Krylov n" "\xC3\xA3" "o "
+               "atingiu a toler" "\xC3\xA2" "ncia em t = %g.\n",
+               contexto->tempus);
+            status = EXIT_FAILURE;
+            break;
+         }
+      }else if(chebyshev) propagar_chebyshev();
+      else propagar(h);
+      if(passo % passos_monitor == 0UL && monitorar(t) != 0){
+         status = EXIT_FAILURE;
+         break;
+      }
+      if(passo % passos_escrita == 0UL && escrever(t) != 0){
+         status = EXIT_FAILURE;
+         break;
+      }
+   }
+
+   if(contexto != NULL){
+      if(deriva != NULL){
+         fprintf(deriva, "# Krylov: %lu passos, %lu rejeitados, %lu "
+            "produtos H z\n", contexto->acceptati, contexto->rejecti,
+            contexto->evaluationes);
+      }
+      pvi_destrue(contexto);
+   }
+   liberar_sistema();
+   return status;
+}
+
+/* A matriz A = 1 + i h H / 2 eh simetrica (nao hermitiana), com diagonal
+   a_n = 1 + i h e_n / 2 e vizinhos b_n = i h t_n / 2. Sua fatoracao
+   A = L D L^T, com L bidiagonal de diagonal unitaria, tem os pivos
+      d_0 = a_0, d_n = a_n - b_n-1^2 / d_n-1
+   e os multiplicadores l_n = b_n-1 / d_n-1. Como b^2 eh real e negativo,
+   Re d_n >= 1 para todo n, a fatoracao existe e dispensa pivotamento
+   qualquer que seja h. Sao guardados l_n e 1 / d_n. */
+static void fatorar(double h){
+   complexo d, b;
+   size_t n;
+
+   d = CMPLX(1.0, 0.5 * h * energia_sitio[0]);
+   inverso_pivo[0] = 1.0 / d;
+   multiplicador[0] = 0.0;
+   for(n = SIZE_C(1); n < N; ++n){
+      b = CMPLX(0.0, 0.5 * h * salto[n - 1]);
+      multiplicador[n] = vezes(b, inverso_pivo[n - 1]);
+      d = CMPLX(1.0, 0.5 * h * energia_sitio[n]) - vezes(multiplicador[n], b);
+      inverso_pivo[n] = 1.0 / d;
+   }
+}
+
+/* Um passo de Crank-Nicolson: o lado direito (1 - i h H / 2) z, a
+   substituicao para a frente com L e a para tras com D L^T, tres
+   varreduras de O(N) sem nenhuma divisao. */
+static void propagar(double h){
+   const double meio = 0.5 * h;
+   complexo *w = lado_direito, hz;
+   size_t n;
+
+   for(n = SIZE_C(0); n < N; ++n){
+      hz = energia_sitio[n] * z[n];
+      if(n > SIZE_C(0)) hz += salto[n - 1] * z[n - 1];
+      if(n + 1 < N) hz += salto[n] * z[n + 1];
+      w[n] = CMPLX(creal(z[n]) + meio * cimag(hz),
+         cimag(z[n]) - meio * creal(hz));
+   }
+   for(n = SIZE_C(1); n < N; ++n)
+      w[n] -= vezes(multiplicador[n], w[n - 1]);
+   z[N - 1] = vezes(w[N - 1], inverso_pivo[N - 1]);
+   for(n = N - 1; n-- > SIZE_C(0); ){
+      z[n] = vezes(w[n], inverso_pivo[n]) -
+         vezes(multiplicador[n + 1], z[n + 1]);
+   }
+}
+
+/* Os limites do espectro vem dos discos de Gershgorin,
+   e_n +- (|t_n-1| + |t_n|), que para uma cadeia com saltos da mesma
+   ordem ficam rentes ao espectro verdadeiro e dispensam as iteracoes de
+   Lanczos. Com x = raio h,
+      exp(-i H h) = exp(-i centro h) sum_k a_k (-i)^k J_k(x) T_k(Hs),
+   a_0 = 1 e a_k = 2, e as funcoes de Bessel J_k(x) vem da recorrencia de
+   Miller, de cima para baixo a partir de uma ordem em que J_k ja eh
+   desprezivel, normalizada por J_0 + 2 sum J_2k = 1. Para k > x elas
+   decaem mais que exponencialmente, e a serie eh truncada na ultima
+   ordem com |J_k| acima de 1e-17: como |T_k(Hs) z| <= |z|, o erro de
+   truncamento fica abaixo do arredondamento. A ordem cresce como
+   x + O(x^1/3), o custo por unidade de tempo nao depende de h. */
+static int preparar_chebyshev(double h){
+   double menor = HUGE_VAL, maior = -HUGE_VAL, disco, x, *J, proximo,
+      soma;
+   complexo fase;
+   size_t n, k, inicio;
+
+   for(n = SIZE_C(0); n < N; ++n){
+      disco = (n > SIZE_C(0) ? fabs(salto[n - 1]) : 0.0) +
+         (n + 1 < N ? fabs(salto[n]) : 0.0);
+      if(energia_sitio[n] - disco < menor) menor = energia_sitio[n] - disco;
+      if(energia_sitio[n] + disco > maior) maior = energia_sitio[n] + disco;
+   }
+   centro_espectro = 0.5 * (maior + menor);
+   raio_espectro = 0.5 * (maior - menor);
+   /* espectro degenerado: qualquer raio positivo serve */
+   if(!(raio_espectro > DBL_EPSILON * (1.0 + fabs(centro_espectro))))
+      raio_espectro = DBL_EPSILON * (1.0 + fabs(centro_espectro));
+
+   x = raio_espectro * h;
+   inicio = (size_t)(x + 12.0 * cbrt(x) + 40.0);
+   J = malloc((inicio + 2) * sizeof(*J));
+   coeficientes = malloc((inicio + 1) * sizeof(*coeficientes));
+   if(J == NULL || coeficientes == NULL){
+      fputs(
+         "ERRO: "
+         "N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente mem" "\xC3\xB3" "ria.\n",
+         stderr
+      );
+      free(J);
+      return EXIT_FAILURE;
+   }
+   J[inicio + 1] = 0.0;
+   J[inicio] = 1e-300;
+   for(k = inicio; k > SIZE_C(0); --k){
+      proximo = 2.0 * (double)k / x * J[k] - J[k + 1];
+      J[k - 1] = proximo;
+      /* reescala o que ja foi calculado antes de transbordar */
+      if(fabs(proximo) > 1e250){
+         for(n = k - 1; n <= inicio; ++n) J[n] *= 1e-250;
+      }
+   }
+   soma = J[0];
+   for(k = SIZE_C(2); k <= inicio; k += 2) soma += 2.0 * J[k];
+   for(ordem = inicio; ordem > SIZE_C(0) && !(fabs(J[ordem]) > 1e-17 *
+      fabs(soma)); --ordem);
+
+   fase = CMPLX(cos(centro_espectro * h), -sin(centro_espectro * h));
+   for(k = SIZE_C(0); k <= ordem; ++k){
+      x = (k == SIZE_C(0) ? 1.0 : 2.0) * J[k] / soma;
+      /* (-i)^k */
+      switch(k % 4){
+         case 0: coeficientes[k] = x * fase; break;
+         case 1: coeficientes[k] = vezes(CMPLX(0.0, -x), fase); break;
+         case 2: coeficientes[k] = -x * fase; break;
+         default: coeficientes[k] = vezes(CMPLX(0.0, x), fase); break;
+      }
+   }
+   free(J);
    return EXIT_SUCCESS;
 }
+
+/* (H - centro) v / raio no sitio n */
+#define HS(v, n) (((energia_sitio[n] - centro_espectro) * (v)[n] +\
+   ((n) > SIZE_C(0) ? salto[(n) - 1] * (v)[(n) - 1] : 0.0) +\
+   ((n) + 1 < N ? salto[n] * (v)[(n) + 1] : 0.0)) * inverso_raio)
+
+/* Um salto exp(-i H h) z pela recorrencia T_k+1 = 2 Hs T_k - T_k-1, que
+   so precisa do produto esparso de H por um vetor a cada ordem. O novo
+   termo sobrescreve o de duas ordens atras, que nao eh mais lido. */
+static void propagar_chebyshev(void){
+   const double inverso_raio = 1.0 / raio_espectro;
+   complexo *t0 = anterior, *t1 = atual, *troca;
+   size_t n, k;
+
+   for(n = SIZE_C(0); n < N; ++n) t0[n] = z[n];
+   for(n = SIZE_C(0); n < N; ++n){
+      t1[n] = HS(t0, n);
+      z[n] = vezes(coeficientes[0], t0[n]);
+   }
+   for(n = SIZE_C(0); n < N && ordem > SIZE_C(0); ++n)
+      z[n] += vezes(coeficientes[1], t1[n]);
+   for(k = SIZE_C(2); k <= ordem; ++k){
+      for(n = SIZE_C(0); n < N; ++n){
+         t0[n] = 2.0 * HS(t1, n) - t0[n];
+         z[n] += vezes(coeficientes[k], t0[n]);
+      }
+      troca = t0;
+      t0 = t1;
+      t1 = troca;
+   }
+}
+
+/* F = D X para o integrador de Krylov: d Re z_n / dt = (H Im z)_n e
+   d Im z_n / dt = -(H Re z)_n, os indices a e b contam doubles */
+static void aplicar_hamiltoniano(size_t a, size_t b, double t,
+   double *X, double *F, void *data){
+   size_t i, n, outra;
+   double hx;
+   (void)t;
+   (void)data;
+
+   for(i = a; i < b; ++i){
+      n = i / 2;
+      outra = i ^ SIZE_C(1);
+      hx = energia_sitio[n] * X[outra];
+      if(n > SIZE_C(0)) hx += salto[n - 1] * X[outra - 2];
+      if(n + 1 < N) hx += salto[n] * X[outra + 2];
+      F[i] = (i & SIZE_C(1) ? -hx : hx);
+   }
+}
+
+/* soma compensada de Kahan */
+#define KAHAN(soma, compensacao, x) do {\
+   const double y_ = (x) - (compensacao), t_ = (soma) + y_;\
+   (compensacao) = (t_ - (soma)) - y_;\
+   (soma) = t_;\
+} while(0)
+
+static void medir(double *norma, double *energia, double *centro,
+   double *espalhamento, double *participacao){
+   double s = 0.0, c = 0.0, e = 0.0, x = 0.0, x2 = 0.0, s2 = 0.0, p;
+   complexo hz;
+   size_t n;
+
+   for(n = SIZE_C(0); n < N; ++n){
+      p = creal(z[n]) * creal(z[n]) + cimag(z[n]) * cimag(z[n]);
+      KAHAN(s, c, p);
+      if(energia == NULL) continue;
+      hz = energia_sitio[n] * z[n];
+      if(n > SIZE_C(0)) hz += salto[n - 1] * z[n - 1];
+      if(n + 1 < N) hz += salto[n] * z[n + 1];
+      e += creal(z[n]) * creal(hz) + cimag(z[n]) * cimag(hz);
+      x += (double)n * p;
+      x2 += (double)n * (double)n * p;
+      s2 += p * p;
+   }
+   *norma = s;
+   if(energia == NULL) return;
+   *energia = e / s;
+   *centro = x / s;
+   p = x2 / s - *centro * *centro;
+   *espalhamento = (p > 0.0 ? sqrt(p) : 0.0);
+   *participacao = s * s / s2;
+}
+
+static int monitorar(double t){
+   double norma, desvio;
+
+   medir(&norma, NULL, NULL, NULL, NULL);
+   desvio = (norma - norma_inicial) / norma_inicial;
+   if(deriva != NULL) fprintf(deriva, "%.10g %.6e\n", t, desvio);
+   if(tolerancia > 0.0 && !(fabs(desvio) <= tolerancia)){
+      fprintf(stderr, "A norma n" "\xC3\xA3" "o foi conservada "
+         "(desvio relativo %g em t = %g).\n", desvio, t);
+      return 1;
+   }
+   return 0;
+}
+
+static int escrever(double t){
+   double o[5];
+   size_t n;
+
+   if(observaveis){
+      medir(o, o + 1, o + 2, o + 3, o + 4);
+      printf("%g %.12g %.12g %.12g %.12g %.12g\n",
+         t, o[0], o[1], o[2], o[3], o[4]);
+   }else{
+      for(n = SIZE_C(0); n < N; ++n)
+         printf("%g %u %g %g\n", t, (unsigned)n, creal(z[n]), cimag(z[n]));
+      printf("\n");
+   }
+   return ferror(stdout) ? 1 : 0;
+}
+
+static int alocar_sistema(size_t sitios){
+   N = sitios;
+   /* z, lado_direito, multiplicador, inverso_pivo, anterior e atual sao
+      complexos, duas partes de double cada */
+   if(pvi_arena_para(&memoria, SIZE_C(chebyshev ? 14 : 10), N) != 0){
+      fputs(
+         "ERRO: "
+         "N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente mem" "\xC3\xB3" "ria.\n",
+         stderr
+      );
+      return EXIT_FAILURE;
+   }
+   energia_sitio = pvi_arena_pars(&memoria, SIZE_C(0));
+   salto = pvi_arena_pars(&memoria, SIZE_C(1));
+   z = (complexo*)(void*)pvi_arena_pars(&memoria, SIZE_C(2));
+   lado_direito = (complexo*)(void*)pvi_arena_pars(&memoria, SIZE_C(4));
+   multiplicador = (complexo*)(void*)pvi_arena_pars(&memoria, SIZE_C(6));
+   inverso_pivo = (complexo*)(void*)pvi_arena_pars(&memoria, SIZE_C(8));
+   if(chebyshev){
+      anterior = (complexo*)(void*)pvi_arena_pars(&memoria, SIZE_C(10));
+      atual = (complexo*)(void*)pvi_arena_pars(&memoria, SIZE_C(12));
+   }
+   return EXIT_SUCCESS;
+}
+
+/* Le o formato binario de `cadeia.h`, com as colunas e_n, t_n, Re z_n e
+   Im z_n no lugar de massa, acoplamento, deslocamento e momento. As
+   colunas Re z_n e Im z_n sao lidas em lado_direito, que ainda nao esta
+   em uso, e so depois juntadas em z. */
+static int ler_binario(FILE *arquivo, const char *nome_arquivo){
+   cabecalho_cadeia cabecalho;
+   double *partes;
+   size_t n;
+
+   if(
+      fread(&cabecalho, sizeof(cabecalho), SIZE_C(1), arquivo) != SIZE_C(1) ||
+      cabecalho.versao != CADEIA_VERSAO || cabecalho.tipo != CADEIA_DOUBLE ||
+      cabecalho.N == UINT64_C(0)
+   ){
+      fprintf(stderr, "ERRO: %s n" "\xC3\xA3" "o " "\xC3\xA9" " uma "
+         "cadeia bin" "\xC3\xA1" "ria v" "\xC3\xA1" "lida.\n", nome_arquivo);
+      return EXIT_FAILURE;
+   }
+   if(alocar_sistema((size_t)cabecalho.N) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+   partes = (double*)(void*)lado_direito;
+   if(
+      fread(energia_sitio, sizeof(double), N, arquivo) != N ||
+      fread(salto, sizeof(double), N, arquivo) != N ||
+      fread(partes, sizeof(double), 2 * N, arquivo) != 2 * N
+   ){
+      fprintf(stderr, "ERRO: %s n" "\xC3\xA3" "o " "\xC3\xA9" " uma "
+         "cadeia bin" "\xC3\xA1" "ria v" "\xC3\xA1" "lida.\n", nome_arquivo);
+      return EXIT_FAILURE;
+   }
+   for(n = SIZE_C(0); n < N; ++n) z[n] = CMPLX(partes[n], partes[N + n]);
+   return EXIT_SUCCESS;
+}
+
+/* Por hipotese o arquivo de texto tem N linhas com quatro colunas: a
+   energia do sitio, o salto para o sitio seguinte e as partes real e
+   imaginaria de z inicial. Ele eh lido duas vezes, a primeira so conta
+   as linhas. */
+static int ler_texto(FILE *arquivo, const char *nome_arquivo){
+   char linha[1024];
+   double x[4];
+   size_t n = SIZE_C(0);
+   int fim;
+
+   while(fgets(linha, (int)sizeof(linha), arquivo) != NULL) ++n;
+   if(n == SIZE_C(0)){
+      fprintf(stderr, "ERRO: %s n" "\xC3\xA3" "o descreve nenhum "
+         "s" "\xC3\xAD" "tio.\n", nome_arquivo);
+      return EXIT_FAILURE;
+   }
+   if(alocar_sistema(n) != EXIT_SUCCESS) return EXIT_FAILURE;
+   rewind(arquivo);
+   for(n = SIZE_C(0); n < N; ++n){
+      fim = 0;
+      if(
+         fgets(linha, (int)sizeof(linha), arquivo) == NULL ||
+         sscanf(linha, "%lf %lf %lf %lf %n",
+            &x[0], &x[1], &x[2], &x[3], &fim) != 4 ||
+         linha[fim] != '\0'
+      ){
+         fprintf(stderr, "ERRO: A linha %zu de %s n" "\xC3\xA3" "o tem "
+            "quatro n" "\xC3\xBA" "meros.\n", n + 1, nome_arquivo);
+         return EXIT_FAILURE;
+      }
+      energia_sitio[n] = x[0];
+      salto[n] = x[1];
+      z[n] = CMPLX(x[2], x[3]);
+   }
+   return EXIT_SUCCESS;
+}
+
+/* Se o arquivo comecar com CADEIA_MAGICA eh lido no formato binario (ver
+   cadeia.h), se nao no formato texto. */
+static int preparar_sistema(const char *nome_arquivo){
+   char magica[sizeof(CADEIA_MAGICA)];
+   FILE *arquivo;
+   int status;
+
+   arquivo = fopen(nome_arquivo, "rb");
+   if(arquivo == NULL){
+      fputs(
+         "ERRO: "
+         "N" "\xC3\xA3" "o foi poss" "\xC3\xAD" "vel "
+         "abrir o arquivo para leitura.\n",
+         stderr
+      );
+      return EXIT_FAILURE;
+   }
+   if(
+      fread(magica, sizeof(magica), SIZE_C(1), arquivo) == SIZE_C(1) &&
+      memcmp(magica, CADEIA_MAGICA, sizeof(CADEIA_MAGICA)) == 0
+   ){
+      rewind(arquivo);
+      status = ler_binario(arquivo, nome_arquivo);
+   }else{
+      rewind(arquivo);
+      status = ler_texto(arquivo, nome_arquivo);
+   }
+   fclose(arquivo);
+   if(status != EXIT_SUCCESS){
+      liberar_sistema();
+      return status;
+   }
+
+   medir(&norma_inicial, NULL, NULL, NULL, NULL);
+   if(!(norma_inicial > 0.0)){
+      fprintf(stderr, "ERRO: A fun" "\xC3\xA7\xC3\xA3" "o de onda inicial "
+         "de %s " "\xC3\xA9" " nula.\n", nome_arquivo);
+      liberar_sistema();
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+}
+
+static void liberar_sistema(void){
+   pvi_arena_libera(&memoria);
+   energia_sitio = salto = NULL;
+   z = lado_direito = multiplicador = inverso_pivo = anterior = atual = NULL;
+   free(coeficientes);
+   coeficientes = NULL;
+   if(deriva != NULL) fclose(deriva);
+   deriva = NULL;
+}
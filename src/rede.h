@@ -0,0 +1,365 @@
+/* *****************************************************************************
+   Copyright (c) 2025 I.F.F. dos Santos <ismaellxd@gmail.com>
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the “Software”), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+***************************************************************************** */
+#ifndef REDE_H
+#define REDE_H 1
+/* ---
+   Campo vetorial da rede harmonica de `classico`, separado para que o
+   programa `desempenho` meca os mesmos nucleos. Inclua antes de pvi.h,
+   com PVI_CORPUS definido como `real`.
+--- */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+#ifndef SIZE_C
+#define SIZE_C(x) ((size_t)(x))
+#endif
+
+/* Precisao das grandezas da rede, escolhida na compilacao: double por
+   padrao, float com -DCLASSICO_FLOAT, long double com
+   -DCLASSICO_LONG_DOUBLE e __float128 (quadrupla em software, GCC e
+   Clang) com -DCLASSICO_QUAD. A energia e os observaveis sao somados em
+   `acumulador`, que nunca tem menos bits que o double, os arquivos de
+   entrada sao lidos e os quadros sao escritos em double. Custo e maior
+   desvio relativo da energia ate t = 100 numa cadeia desordenada de 4096
+   corpos em equilibrio, yoshida8 com h = 1/64, um nucleo com AVX-512:
+      float          0.55 s   6.9e-07
+      double         1.0 s    1.2e-15
+      long double    12.5 s   2.7e-17
+      __float128     311 s    2.7e-17
+   Nas duas ultimas o que resta eh o erro do proprio esquema. */
+#if defined(CLASSICO_FLOAT)
+typedef float real;
+typedef double acumulador;
+#define REAL_MANTISSA FLT_MANT_DIG
+#define REAL_NOME "float"
+#elif defined(CLASSICO_LONG_DOUBLE)
+typedef long double real;
+typedef long double acumulador;
+#define REAL_MANTISSA LDBL_MANT_DIG
+#define REAL_NOME "long double"
+#elif defined(CLASSICO_QUAD)
+typedef __float128 real;
+typedef __float128 acumulador;
+#define REAL_MANTISSA 113
+#define REAL_NOME "__float128"
+#else
+#define CLASSICO_DOUBLE 1
+typedef double real;
+typedef double acumulador;
+#define REAL_MANTISSA DBL_MANT_DIG
+#define REAL_NOME "double"
+#endif
+
+/* Parametros lidos pelo campo vetorial, que os recebe pelo ponteiro `data`
+   do contexto do integrador e nao pelas variaveis globais. */
+typedef struct {
+   size_t R;
+   real *kappa, *inv_massa;
+} rede;
+
+/* Versao em blocos de `dot_Q` e `dot_P`, no formato de `gradus_X` e
+   `gradus_Y` do contexto do integrador. A implementacao (escalar, SSE2,
+   AVX2 ou AVX-512) eh escolhida por `escolher_nucleos` ao iniciar, em
+   long double e __float128 so ha a escalar. Os nucleos sao `inline` para
+   que `classico` os embuta no laco do integrador (ver `curre`). */
+typedef void (*nucleo)(size_t a, size_t b, double c,
+   real *X, real *Y, void *data);
+
+/* componentes do campo vetorial hamiltoniano */
+static inline real dot_Q(const rede *s, size_t n, real *P){
+   return P[n] * s->inv_massa[n];
+}
+static inline real dot_P(const rede *s, size_t n, real *Q){
+   const size_t R = s->R;
+   return s->kappa[n] * (Q[n+R] - Q[n]) - s->kappa[n-R] * (Q[n] - Q[n-R]);
+}
+
+/* Os nucleos vetoriais fazem exatamente as mesmas operacoes, na mesma
+   ordem, que `dot_Q` e `dot_P` (a contracao em FMA eh desligada), entao o
+   resultado nao depende do conjunto de instrucoes escolhido. O resto de
+   cada bloco eh feito no proprio nucleo, e nao chamando a versao escalar,
+   para evitar a penalidade de transicao entre AVX e SSE. */
+static inline void arrastar_escalar(size_t a, size_t b, double c,
+   real *Q, real *P, void *data){
+   for(size_t n = a; n < b; ++n) Q[n] += dot_Q(data, n, P) * (real)c;
+}
+static inline void chutar_escalar(size_t a, size_t b, double c,
+   real *P, real *Q, void *data){
+   for(size_t n = a; n < b; ++n) P[n] += dot_P(data, n, Q) * (real)c;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+   (defined(CLASSICO_DOUBLE) || defined(CLASSICO_FLOAT))
+#define NUCLEOS_VETORIAIS 1
+#include <immintrin.h>
+#endif
+
+#if defined(NUCLEOS_VETORIAIS) && defined(CLASSICO_DOUBLE)
+__attribute__((target("sse2"), optimize("fp-contract=off")))
+static inline void arrastar_sse2(size_t a, size_t b, double c,
+   double *Q, double *P, void *data){
+   const double *inv_massa = ((const rede*)data)->inv_massa;
+   size_t n = a;
+   __m128d vc = _mm_set1_pd(c), f;
+   for(; n + SIZE_C(2) <= b; n += SIZE_C(2)){
+      f = _mm_mul_pd(_mm_loadu_pd(P + n), _mm_loadu_pd(inv_massa + n));
+      _mm_storeu_pd(Q + n, _mm_add_pd(_mm_loadu_pd(Q + n), _mm_mul_pd(f, vc)));
+   }
+   for(; n < b; ++n) Q[n] += dot_Q(data, n, P) * c;
+}
+__attribute__((target("sse2"), optimize("fp-contract=off")))
+static inline void chutar_sse2(size_t a, size_t b, double c,
+   double *P, double *Q, void *data){
+   const double *kappa = ((const rede*)data)->kappa;
+   const size_t R = ((const rede*)data)->R;
+   size_t n = a;
+   __m128d vc = _mm_set1_pd(c), q, f;
+   for(; n + SIZE_C(2) <= b; n += SIZE_C(2)){
+      q = _mm_loadu_pd(Q + n);
+      f = _mm_sub_pd(
+         _mm_mul_pd(_mm_loadu_pd(kappa + n), _mm_sub_pd(_mm_loadu_pd(Q + n + R), q)),
+         _mm_mul_pd(_mm_loadu_pd(kappa + n - R), _mm_sub_pd(q, _mm_loadu_pd(Q + n - R)))
+      );
+      _mm_storeu_pd(P + n, _mm_add_pd(_mm_loadu_pd(P + n), _mm_mul_pd(f, vc)));
+   }
+   for(; n < b; ++n) P[n] += dot_P(data, n, Q) * c;
+}
+
+__attribute__((target("avx2"), optimize("fp-contract=off")))
+static inline void arrastar_avx2(size_t a, size_t b, double c,
+   double *Q, double *P, void *data){
+   const double *inv_massa = ((const rede*)data)->inv_massa;
+   size_t n = a;
+   __m256d vc = _mm256_set1_pd(c), f;
+   for(; n + SIZE_C(4) <= b; n += SIZE_C(4)){
+      f = _mm256_mul_pd(_mm256_loadu_pd(P + n), _mm256_loadu_pd(inv_massa + n));
+      _mm256_storeu_pd(Q + n,
+         _mm256_add_pd(_mm256_loadu_pd(Q + n), _mm256_mul_pd(f, vc)));
+   }
+   for(; n < b; ++n) Q[n] += dot_Q(data, n, P) * c;
+}
+__attribute__((target("avx2"), optimize("fp-contract=off")))
+static inline void chutar_avx2(size_t a, size_t b, double c,
+   double *P, double *Q, void *data){
+   const double *kappa = ((const rede*)data)->kappa;
+   const size_t R = ((const rede*)data)->R;
+   size_t n = a;
+   __m256d vc = _mm256_set1_pd(c), q, f;
+   for(; n + SIZE_C(4) <= b; n += SIZE_C(4)){
+      q = _mm256_loadu_pd(Q + n);
+      f = _mm256_sub_pd(
+         _mm256_mul_pd(_mm256_loadu_pd(kappa + n),
+            _mm256_sub_pd(_mm256_loadu_pd(Q + n + R), q)),
+         _mm256_mul_pd(_mm256_loadu_pd(kappa + n - R),
+            _mm256_sub_pd(q, _mm256_loadu_pd(Q + n - R)))
+      );
+      _mm256_storeu_pd(P + n,
+         _mm256_add_pd(_mm256_loadu_pd(P + n), _mm256_mul_pd(f, vc)));
+   }
+   for(; n < b; ++n) P[n] += dot_P(data, n, Q) * c;
+}
+
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+static inline void arrastar_avx512(size_t a, size_t b, double c,
+   double *Q, double *P, void *data){
+   const double *inv_massa = ((const rede*)data)->inv_massa;
+   size_t n = a;
+   __m512d vc = _mm512_set1_pd(c), f;
+   for(; n + SIZE_C(8) <= b; n += SIZE_C(8)){
+      f = _mm512_mul_pd(_mm512_loadu_pd(P + n), _mm512_loadu_pd(inv_massa + n));
+      _mm512_storeu_pd(Q + n,
+         _mm512_add_pd(_mm512_loadu_pd(Q + n), _mm512_mul_pd(f, vc)));
+   }
+   for(; n < b; ++n) Q[n] += dot_Q(data, n, P) * c;
+}
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+static inline void chutar_avx512(size_t a, size_t b, double c,
+   double *P, double *Q, void *data){
+   const double *kappa = ((const rede*)data)->kappa;
+   const size_t R = ((const rede*)data)->R;
+   size_t n = a;
+   __m512d vc = _mm512_set1_pd(c), q, f;
+   for(; n + SIZE_C(8) <= b; n += SIZE_C(8)){
+      q = _mm512_loadu_pd(Q + n);
+      f = _mm512_sub_pd(
+         _mm512_mul_pd(_mm512_loadu_pd(kappa + n),
+            _mm512_sub_pd(_mm512_loadu_pd(Q + n + R), q)),
+         _mm512_mul_pd(_mm512_loadu_pd(kappa + n - R),
+            _mm512_sub_pd(q, _mm512_loadu_pd(Q + n - R)))
+      );
+      _mm512_storeu_pd(P + n,
+         _mm512_add_pd(_mm512_loadu_pd(P + n), _mm512_mul_pd(f, vc)));
+   }
+   for(; n < b; ++n) P[n] += dot_P(data, n, Q) * c;
+}
+#elif defined(NUCLEOS_VETORIAIS)
+/* Em float cada registrador leva o dobro de corpos. */
+__attribute__((target("sse2"), optimize("fp-contract=off")))
+static inline void arrastar_sse2(size_t a, size_t b, double c,
+   float *Q, float *P, void *data){
+   const float *inv_massa = ((const rede*)data)->inv_massa;
+   size_t n = a;
+   __m128 vc = _mm_set1_ps((float)c), f;
+   for(; n + SIZE_C(4) <= b; n += SIZE_C(4)){
+      f = _mm_mul_ps(_mm_loadu_ps(P + n), _mm_loadu_ps(inv_massa + n));
+      _mm_storeu_ps(Q + n, _mm_add_ps(_mm_loadu_ps(Q + n), _mm_mul_ps(f, vc)));
+   }
+   for(; n < b; ++n) Q[n] += dot_Q(data, n, P) * (real)c;
+}
+__attribute__((target("sse2"), optimize("fp-contract=off")))
+static inline void chutar_sse2(size_t a, size_t b, double c,
+   float *P, float *Q, void *data){
+   const float *kappa = ((const rede*)data)->kappa;
+   const size_t R = ((const rede*)data)->R;
+   size_t n = a;
+   __m128 vc = _mm_set1_ps((float)c), q, f;
+   for(; n + SIZE_C(4) <= b; n += SIZE_C(4)){
+      q = _mm_loadu_ps(Q + n);
+      f = _mm_sub_ps(
+         _mm_mul_ps(_mm_loadu_ps(kappa + n), _mm_sub_ps(_mm_loadu_ps(Q + n + R), q)),
+         _mm_mul_ps(_mm_loadu_ps(kappa + n - R), _mm_sub_ps(q, _mm_loadu_ps(Q + n - R)))
+      );
+      _mm_storeu_ps(P + n, _mm_add_ps(_mm_loadu_ps(P + n), _mm_mul_ps(f, vc)));
+   }
+   for(; n < b; ++n) P[n] += dot_P(data, n, Q) * (real)c;
+}
+
+__attribute__((target("avx2"), optimize("fp-contract=off")))
+static inline void arrastar_avx2(size_t a, size_t b, double c,
+   float *Q, float *P, void *data){
+   const float *inv_massa = ((const rede*)data)->inv_massa;
+   size_t n = a;
+   __m256 vc = _mm256_set1_ps((float)c), f;
+   for(; n + SIZE_C(8) <= b; n += SIZE_C(8)){
+      f = _mm256_mul_ps(_mm256_loadu_ps(P + n), _mm256_loadu_ps(inv_massa + n));
+      _mm256_storeu_ps(Q + n,
+         _mm256_add_ps(_mm256_loadu_ps(Q + n), _mm256_mul_ps(f, vc)));
+   }
+   for(; n < b; ++n) Q[n] += dot_Q(data, n, P) * (real)c;
+}
+__attribute__((target("avx2"), optimize("fp-contract=off")))
+static inline void chutar_avx2(size_t a, size_t b, double c,
+   float *P, float *Q, void *data){
+   const float *kappa = ((const rede*)data)->kappa;
+   const size_t R = ((const rede*)data)->R;
+   size_t n = a;
+   __m256 vc = _mm256_set1_ps((float)c), q, f;
+   for(; n + SIZE_C(8) <= b; n += SIZE_C(8)){
+      q = _mm256_loadu_ps(Q + n);
+      f = _mm256_sub_ps(
+         _mm256_mul_ps(_mm256_loadu_ps(kappa + n),
+            _mm256_sub_ps(_mm256_loadu_ps(Q + n + R), q)),
+         _mm256_mul_ps(_mm256_loadu_ps(kappa + n - R),
+            _mm256_sub_ps(q, _mm256_loadu_ps(Q + n - R)))
+      );
+      _mm256_storeu_ps(P + n,
+         _mm256_add_ps(_mm256_loadu_ps(P + n), _mm256_mul_ps(f, vc)));
+   }
+   for(; n < b; ++n) P[n] += dot_P(data, n, Q) * (real)c;
+}
+
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+static inline void arrastar_avx512(size_t a, size_t b, double c,
+   float *Q, float *P, void *data){
+   const float *inv_massa = ((const rede*)data)->inv_massa;
+   size_t n = a;
+   __m512 vc = _mm512_set1_ps((float)c), f;
+   for(; n + SIZE_C(16) <= b; n += SIZE_C(16)){
+      f = _mm512_mul_ps(_mm512_loadu_ps(P + n), _mm512_loadu_ps(inv_massa + n));
+      _mm512_storeu_ps(Q + n,
+         _mm512_add_ps(_mm512_loadu_ps(Q + n), _mm512_mul_ps(f, vc)));
+   }
+   for(; n < b; ++n) Q[n] += dot_Q(data, n, P) * (real)c;
+}
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+static inline void chutar_avx512(size_t a, size_t b, double c,
+   float *P, float *Q, void *data){
+   const float *kappa = ((const rede*)data)->kappa;
+   const size_t R = ((const rede*)data)->R;
+   size_t n = a;
+   __m512 vc = _mm512_set1_ps((float)c), q, f;
+   for(; n + SIZE_C(16) <= b; n += SIZE_C(16)){
+      q = _mm512_loadu_ps(Q + n);
+      f = _mm512_sub_ps(
+         _mm512_mul_ps(_mm512_loadu_ps(kappa + n),
+            _mm512_sub_ps(_mm512_loadu_ps(Q + n + R), q)),
+         _mm512_mul_ps(_mm512_loadu_ps(kappa + n - R),
+            _mm512_sub_ps(q, _mm512_loadu_ps(Q + n - R)))
+      );
+      _mm512_storeu_ps(P + n,
+         _mm512_add_ps(_mm512_loadu_ps(P + n), _mm512_mul_ps(f, vc)));
+   }
+   for(; n < b; ++n) P[n] += dot_P(data, n, Q) * (real)c;
+}
+#endif
+
+static const char *const nomes_nucleos[4] = {
+   "escalar", "sse2", "avx2", "avx512"
+};
+
+/* Escolhe o maior conjunto de instrucoes suportado pelo processador,
+   a variavel de ambiente CLASSICO_SIMD (escalar, sse2, avx2 ou avx512)
+   pode ser usada para limitar a escolha; um valor desconhecido limita
+   ao escalar, com um aviso. Retorna o indice do escolhido em
+   `nomes_nucleos`. */
+static int escolher_nucleos(nucleo *arrastar, nucleo *chutar){
+   static int avisado = 0;
+   const char *limite = getenv("CLASSICO_SIMD");
+   int nivel = 0, maximo;
+
+   if(limite != NULL && *limite == '\0') limite = NULL;
+   maximo = (limite != NULL ? -1 : 3);
+
+   for(int k = 0; limite != NULL && k < 4; ++k)
+      if(strcmp(limite, nomes_nucleos[k]) == 0) maximo = k;
+   if(maximo < 0){
+      if(!avisado)
+         fprintf(stderr, "AVISO: CLASSICO_SIMD=%s desconhecido, os valores "
+            "aceitos s" "\xC3\xA3" "o escalar, sse2, avx2 e avx512; usando "
+            "escalar.\n", limite);
+      avisado = 1;
+      maximo = 0;
+   }
+
+#if defined(NUCLEOS_VETORIAIS)
+   __builtin_cpu_init();
+   if(__builtin_cpu_supports("sse2")) nivel = 1;
+   if(__builtin_cpu_supports("avx2")) nivel = 2;
+   if(__builtin_cpu_supports("avx512f")) nivel = 3;
+#endif
+   if(nivel > maximo) nivel = maximo;
+
+   switch(nivel){
+#if defined(NUCLEOS_VETORIAIS)
+      case 3: *arrastar = arrastar_avx512; *chutar = chutar_avx512; break;
+      case 2: *arrastar = arrastar_avx2; *chutar = chutar_avx2; break;
+      case 1: *arrastar = arrastar_sse2; *chutar = chutar_sse2; break;
+#endif
+      default: *arrastar = arrastar_escalar; *chutar = chutar_escalar; break;
+   }
+   return nivel;
+}
+
+#endif /* REDE_H */
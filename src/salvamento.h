@@ -0,0 +1,71 @@
+/* *****************************************************************************
+   Copyright (c) 2025 I.F.F. dos Santos <ismaellxd@gmail.com>
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the “Software”), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+***************************************************************************** */
+#ifndef SALVAMENTO_H
+#define SALVAMENTO_H 1
+/* ---
+   Formato binario do estado salvo por `classico -c`, lido de volta com a
+   opcao -r. O arquivo comeca com um `cabecalho_salvamento` e segue com
+      E: R numeros, a energia inicial de cada realizacao, em double com
+         `mantissa` de ate 53 bits e no proprio tipo das grandezas acima
+         disso (ver `acumulador` em classico.c);
+      saidas: R uint64_t, o tamanho de cada `arquivo.saida` (ou da saida
+         padrao) no momento do salvamento;
+      a memoria das grandezas: 4 * N * R + 3 * R numeros, massa, kappa, Q
+         e P na ordem e com as bordas nulas com que ficam na memoria (o
+         corpo n da realizacao r na posicao n * R + r);
+      ativa: R bytes, 0 para as realizacoes que deixaram de conservar a
+         energia.
+   Os esquemas simpleticos de `classico` dao um passo so com Q e P, sem
+   historia de passos anteriores, entao isso basta para seguir do mesmo
+   ponto com os mesmos bits. Todos os numeros estao na ordem de bytes da
+   maquina que escreveu o arquivo, o campo `tipo` permite detectar a troca.
+   O estado so pode ser retomado por um `classico` compilado com a mesma
+   precisao.
+--- */
+#include <stdint.h>
+
+#define SALVAMENTO_MAGICA "PVISALV"
+#define SALVAMENTO_VERSAO UINT32_C(3)
+/* tamanho de um arquivo que nao pode ser retomado (um pipe, por exemplo) */
+#define SALVAMENTO_SEM_TAMANHO UINT64_MAX
+
+typedef struct {
+   char magica[8]; /* SALVAMENTO_MAGICA com o '\0' */
+   uint32_t versao;
+   uint32_t tipo; /* tamanho em bytes de cada grandeza */
+   uint64_t N; /* numero de corpos */
+   uint64_t R; /* numero de realizacoes */
+   uint32_t esquema; /* o metodo de pvi.h, na ordem da sua enumeracao */
+   uint32_t mantissa; /* bits de mantissa, separa long double de quadrupla */
+   uint64_t passo; /* passos dados */
+   uint64_t escrita; /* indice do proximo instante de escrita */
+   uint64_t por_decada; /* opcao -l, 0 se as escritas sao lineares */
+   double h; /* passo de integracao */
+   double t; /* tempo do integrador, somado passo a passo */
+   double intervalo; /* opcao -i */
+   uint64_t trajetoria; /* tamanho da trajetoria binaria (opcao -b) */
+   uint64_t deriva; /* tamanho do arquivo da opcao -m */
+   double limiar; /* opcao -j, 0 sem ela */
+   uint64_t primeiro, ultimo; /* janela ativa, [0, N) sem a opcao -j */
+} cabecalho_salvamento;
+
+#endif /* SALVAMENTO_H */
@@ -0,0 +1,213 @@
+/* *****************************************************************************
+   Copyright (c) 2025 I.F.F. dos Santos <ismaellxd@gmail.com>
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the “Software”), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+***************************************************************************** */
+#define _POSIX_C_SOURCE 200809L
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "pvi.h"
+/* ---
+   Compara os metodos simpleticos de `pvi.h` pelo custo para atingir um
+   dado erro na energia. Cada esquema integra a mesma cadeia desordenada
+   (massas sorteadas entre 0.5 e 1.5, molas unitarias, paredes fixas nas
+   pontas, um impulso no corpo central e, com a opcao -b, o termo quartico
+   beta (Q_n+1 - Q_n)^4 / 4 de Fermi-Pasta-Ulam) ate o tempo final, com
+   passos cada vez menores. Para cada passo eh escrita uma linha
+      esquema h forcas erro
+   onde `forcas` conta as varreduras de `chutar` (a parte cara do campo)
+   e `erro` eh o maior desvio relativo |H - E| / |E| visto ao fim dos
+   passos. Os subpassos das pontas de passos consecutivos nao sao
+   fundidos, como no integrador. No fim, para cada esquema, o numero de
+   forcas necessario para o erro da opcao -e, interpolado em escala log.
+--- */
+
+#define SIZE_C(x) ((size_t)(x))
+
+typedef struct {
+   size_t N;
+   double beta;
+   const double *inv_massa;
+   unsigned long forcas;
+} cadeia;
+
+/* Q[n] += c * P[n] / m_n */
+static void arrastar(size_t a, size_t b, double c,
+   double *Q, double *P, void *data){
+   const cadeia *s = data;
+   size_t n;
+   for(n = a; n < b; ++n) Q[n] += c * P[n] * s->inv_massa[n];
+}
+
+/* P[n] += c * F_n(Q), com Q = 0 fora da cadeia */
+static void chutar(size_t a, size_t b, double c,
+   double *P, double *Q, void *data){
+   cadeia *s = data;
+   double esquerda, direita;
+   size_t n;
+
+   if(a == SIZE_C(0)) ++s->forcas;
+   for(n = a; n < b; ++n){
+      esquerda = Q[n] - (n > SIZE_C(0) ? Q[n - 1] : 0.0);
+      direita = (n + 1 < s->N ? Q[n + 1] : 0.0) - Q[n];
+      P[n] += c * (direita - esquerda + s->beta * (
+         direita * direita * direita - esquerda * esquerda * esquerda
+      ));
+   }
+}
+
+static double energia(const cadeia *s, const double *Q, const double *P){
+   double H = 0.0, compensacao = 0.0, e, y, t, d;
+   size_t n;
+
+   /* soma compensada, o erro procurado chega perto de 1e-15 */
+   for(n = SIZE_C(0); n <= s->N; ++n){
+      d = (n < s->N ? Q[n] : 0.0) - (n > SIZE_C(0) ? Q[n - 1] : 0.0);
+      e = 0.5 * d * d + 0.25 * s->beta * d * d * d * d;
+      if(n < s->N) e += 0.5 * P[n] * P[n] * s->inv_massa[n];
+      y = e - compensacao;
+      t = H + y;
+      compensacao = (t - H) - y;
+      H = t;
+   }
+   return H;
+}
+
+/* gerador xorshift64*, a mesma desordem em todas as execucoes */
+static uint64_t semente = UINT64_C(88172645463325252);
+static double sortear(void){
+   semente ^= semente >> 12;
+   semente ^= semente << 25;
+   semente ^= semente >> 27;
+   return (double)((semente * UINT64_C(2685821657736338717)) >> 11) *
+      (1.0 / 9007199254740992.0);
+}
+
+static const char *const esquemas_padrao[] = {
+   "ruth3", "ruth4", "yoshida6", "yoshida8", "blanes_moan4", "blanes_moan6",
+   "blanes_moan_rkn4", "blanes_moan_rkn6"
+};
+
+int main(int argc, char **argv){
+   cadeia s;
+   pvi_contextus *contexto;
+   double *buffer, *Q, *P, *inv_massa, E, h, erro, desvio;
+   double tempo_final = 100.0;
+   double alvo = 1e-8, h0 = 0.5, anterior_f, anterior_e, forcas_alvo;
+   const char *const *esquemas = esquemas_padrao;
+   size_t N = SIZE_C(1024), n, quantos;
+   int opcao, metodo, k, divisoes = 8;
+
+   s.beta = 0.0;
+   while((opcao = getopt(argc, argv, "b:e:h:k:n:t:")) != -1){
+      if(opcao == 'b') s.beta = atof(optarg);
+      else if(opcao == 'e') alvo = atof(optarg);
+      else if(opcao == 'h') h0 = atof(optarg);
+      else if(opcao == 'k') divisoes = atoi(optarg);
+      else if(opcao == 'n') N = (size_t)strtoul(optarg, NULL, 10);
+      else if(opcao == 't') tempo_final = atof(optarg);
+      else{
+         fprintf(stderr, "%s [-n corpos] [-t tempo final] [-b beta] "
+            "[-h maior passo] [-k divis" "\xC3\xB5" "es] [-e erro] "
+            "[esquema]...\n", argv[0]);
+         return EXIT_FAILURE;
+      }
+   }
+   quantos = sizeof(esquemas_padrao) / sizeof(*esquemas_padrao);
+   if(optind < argc){
+      esquemas = (const char *const *)(argv + optind);
+      quantos = (size_t)(argc - optind);
+   }
+   if(N < SIZE_C(2)){
+      fputs("ERRO: A cadeia precisa de ao menos dois corpos.\n", stderr);
+      return EXIT_FAILURE;
+   }
+
+   buffer = malloc(3 * N * sizeof(*buffer));
+   if(buffer == NULL){
+      fputs("ERRO: N" "\xC3\xA3" "o h" "\xC3\xA1" " suficiente "
+         "mem" "\xC3\xB3" "ria.\n", stderr);
+      return EXIT_FAILURE;
+   }
+   Q = buffer;
+   P = buffer + N;
+   inv_massa = buffer + 2 * N;
+   for(n = SIZE_C(0); n < N; ++n) inv_massa[n] = 1.0 / (0.5 + sortear());
+   s.N = N;
+   s.inv_massa = inv_massa;
+
+   printf("# esquema h forcas erro\n");
+   for(; quantos > SIZE_C(0); --quantos, ++esquemas){
+      metodo = pvi_methodus(*esquemas);
+      if(metodo < PVI_EULER_S){
+         fprintf(stderr, "ERRO: %s n" "\xC3\xA3" "o " "\xC3\xA9" " um "
+            "m" "\xC3\xA9" "todo simpl" "\xC3\xA9" "tico.\n", *esquemas);
+         continue;
+      }
+      anterior_f = anterior_e = forcas_alvo = HUGE_VAL;
+      for(k = 0, h = h0; k < divisoes; ++k, h *= 0.5){
+         memset(Q, 0, N * sizeof(*Q));
+         memset(P, 0, N * sizeof(*P));
+         P[N / 2] = 1.0 / inv_massa[N / 2];
+         E = energia(&s, Q, P);
+         s.forcas = 0UL;
+
+         contexto = pvi_crea(metodo, N, h);
+         if(contexto == NULL){
+            free(buffer);
+            return EXIT_FAILURE;
+         }
+         contexto->x = Q;
+         contexto->y = P;
+         contexto->gradus_X = arrastar;
+         contexto->gradus_Y = chutar;
+         contexto->data = &s;
+         contexto->fusus = 1;
+         erro = 0.0;
+         while(contexto->tempus < tempo_final - 0.5 * h){
+            pvi_progredere(contexto);
+            desvio = fabs(energia(&s, Q, P) - E) / fabs(E);
+            /* a comparacao negada tambem pega o NaN da instabilidade */
+            if(!(desvio <= erro)) erro = desvio;
+            if(!(erro < 1.0)) break;
+         }
+         pvi_destrue(contexto);
+         if(!(erro < 1.0)) erro = HUGE_VAL;
+
+         printf("%s %.9g %lu %.3e\n", *esquemas, h, s.forcas, erro);
+         if(erro <= alvo && anterior_e > alvo && forcas_alvo == HUGE_VAL){
+            forcas_alvo = (anterior_e == HUGE_VAL ? (double)s.forcas :
+               anterior_f * pow((double)s.forcas / anterior_f,
+                  log(alvo / anterior_e) / log(erro / anterior_e)));
+         }
+         anterior_f = (double)s.forcas;
+         anterior_e = erro;
+      }
+      printf("# %s: %.4g forcas para erro %g\n\n",
+         *esquemas, forcas_alvo, alvo);
+      fflush(stdout);
+   }
+   free(buffer);
+   return EXIT_SUCCESS;
+}
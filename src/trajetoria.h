@@ -0,0 +1,50 @@
+/* *****************************************************************************
+   Copyright (c) 2025 I.F.F. dos Santos <ismaellxd@gmail.com>
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the “Software”), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+***************************************************************************** */
+#ifndef TRAJETORIA_H
+#define TRAJETORIA_H 1
+/* ---
+   Formato binario das trajetorias escritas por `classico -b`.
+   O arquivo comeca com um `cabecalho_trajetoria` e segue com os quadros,
+   cada quadro eh o tempo (um double) seguido de Q e de P, ambos com N * R
+   doubles na ordem em que ficam na memoria (o corpo n da realizacao r na
+   posicao n * R + r). Todos os numeros estao na ordem de bytes da maquina
+   que escreveu o arquivo, o campo `tipo` permite detectar a troca. Os
+   quadros sao em double qualquer que seja a precisao de `classico`.
+--- */
+#include <stdint.h>
+
+#define TRAJETORIA_MAGICA "PVITRAJ"
+#define TRAJETORIA_VERSAO UINT32_C(1)
+/* tamanho em bytes de cada numero, escrito na ordem de bytes nativa */
+#define TRAJETORIA_DOUBLE UINT32_C(8)
+
+typedef struct {
+   char magica[8]; /* TRAJETORIA_MAGICA com o '\0' */
+   uint32_t versao;
+   uint32_t tipo;
+   uint64_t N; /* numero de corpos */
+   uint64_t R; /* numero de realizacoes */
+   double h; /* passo de integracao, 0 pelos modos normais */
+   double intervalo; /* tempo entre dois quadros, 0 se logaritmicos */
+} cabecalho_trajetoria;
+
+#endif /* TRAJETORIA_H */
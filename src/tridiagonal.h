@@ -0,0 +1,113 @@
+/* *****************************************************************************
+   Copyright (c) 2025 I.F.F. dos Santos <ismaellxd@gmail.com>
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the “Software”), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+***************************************************************************** */
+#ifndef TRIDIAGONAL_H
+#define TRIDIAGONAL_H 1
+/* ---
+   Autovalores e autovetores de uma matriz real simetrica tridiagonal pelo
+   algoritmo QL implicito com deslocamento de Wilkinson (o `tqli` de
+   Numerical Recipes), sem depender do LAPACK. O custo eh O(N^2) so para
+   os autovalores e O(N^3) com os autovetores.
+--- */
+#include <stddef.h>
+#include <float.h>
+#include <math.h>
+
+/* Na entrada d[n] eh a diagonal e e[n] liga n a n + 1 (e[N-1] eh usado
+   como area de trabalho). Na saida d tem os autovalores em ordem
+   crescente e, se Z nao for NULL, a linha Z[k * N ...] eh o autovetor
+   normalizado de d[k]: as rotacoes misturam linhas inteiras, que ficam
+   contiguas na memoria. Retorna diferente de 0 se alguma iteracao nao
+   convergir. */
+static int diagonalizar_tridiagonal(size_t N, double *d, double *e,
+   double *Z){
+   ptrdiff_t l, m, i, n = (ptrdiff_t)N;
+   size_t k, j;
+   double s, c, p, g, r, f, b, dd;
+   int iteracoes;
+
+   if(Z != NULL){
+      for(k = 0; k < N * N; ++k) Z[k] = 0.0;
+      for(k = 0; k < N; ++k) Z[k * N + k] = 1.0;
+   }
+   if(N == 0) return 0;
+   e[N - 1] = 0.0;
+   for(l = 0; l < n; ++l){
+      iteracoes = 0;
+      do{
+         for(m = l; m < n - 1; ++m){
+            dd = fabs(d[m]) + fabs(d[m + 1]);
+            if(fabs(e[m]) <= DBL_EPSILON * dd) break;
+         }
+         if(m == l) break;
+         if(iteracoes++ == 60) return 1;
+         g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+         r = hypot(g, 1.0);
+         g = d[m] - d[l] + e[l] / (g + (g >= 0.0 ? r : -r));
+         s = c = 1.0;
+         p = 0.0;
+         for(i = m - 1; i >= l; --i){
+            f = s * e[i];
+            b = c * e[i];
+            e[i + 1] = (r = hypot(f, g));
+            /* subdiagonal anulada: o bloco se partiu antes de chegar em l */
+            if(r == 0.0){
+               d[i + 1] -= p;
+               e[m] = 0.0;
+               break;
+            }
+            s = f / r;
+            c = g / r;
+            g = d[i + 1] - p;
+            r = (d[i] - g) * s + 2.0 * c * b;
+            d[i + 1] = g + (p = s * r);
+            g = c * r - b;
+            if(Z == NULL) continue;
+            for(j = 0; j < N; ++j){
+               f = Z[(size_t)(i + 1) * N + j];
+               Z[(size_t)(i + 1) * N + j] = s * Z[(size_t)i * N + j] + c * f;
+               Z[(size_t)i * N + j] = c * Z[(size_t)i * N + j] - s * f;
+            }
+         }
+         if(r == 0.0 && i >= l) continue;
+         d[l] -= p;
+         e[l] = g;
+         e[m] = 0.0;
+      }while(m != l);
+   }
+
+   /* ordenacao por selecao, O(N^2) com as trocas de linhas */
+   for(k = 0; k + 1 < N; ++k){
+      for(i = (ptrdiff_t)k, l = i + 1; l < n; ++l) if(d[l] < d[i]) i = l;
+      if(i == (ptrdiff_t)k) continue;
+      p = d[k];
+      d[k] = d[i];
+      d[i] = p;
+      for(j = 0; Z != NULL && j < N; ++j){
+         p = Z[k * N + j];
+         Z[k * N + j] = Z[(size_t)i * N + j];
+         Z[(size_t)i * N + j] = p;
+      }
+   }
+   return 0;
+}
+
+#endif /* TRIDIAGONAL_H */